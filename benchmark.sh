@@ -0,0 +1,40 @@
+#!/bin/bash
+
+# Time-to-trust benchmark: sweeps the number of producers in /zoneA and appends
+# one CSV row per run (see --nTimeToTrust in main.cc) to $RESULTS_CSV
+
+# set exit status of the pipeline to the rightmost command with nonzero exit status
+set -o pipefail
+
+# important paths and files definition
+RESULTS_DIR=~/ndnSIM/ns-3/results
+
+if [ -z "$PRODUCERS" ]; then
+    # producers per zone to sweep
+    PRODUCERS="10 100 1000"
+fi
+if [ -z "$CONSUMERS" ]; then
+    CONSUMERS=1
+fi
+if [ -z "$SIM_DURATION" ]; then
+    # simulation duration in seconds (time-to-trust is -1 if not reached)
+    SIM_DURATION=60
+fi
+if [ -z "$RESULTS_CSV" ]; then
+    RESULTS_CSV=${RESULTS_DIR}/time-to-trust.csv
+fi
+if [ -z "$RUN_LABEL" ]; then
+    # label rows with the commit, to compare results across commits
+    RUN_LABEL=$(git -C "$(dirname "$0")" rev-parse --short HEAD 2>/dev/null || echo "unknown")
+fi
+
+mkdir -p $RESULTS_DIR
+
+for N in $PRODUCERS; do
+    echo "Running time-to-trust benchmark: producers=$N consumers=$CONSUMERS ..."
+    ( cd ~/ndnSIM/ns-3 &&
+      NS_LOG="" ./waf --run="sim_bootsec -nSimDuration=${SIM_DURATION} -n_Producers=$N -n_Consumers=$CONSUMERS -nTimeToTrust=${RESULTS_CSV} -nRunLabel=${RUN_LABEL} $*" ) ||
+    { echo "ERROR - benchmark run failed (producers=$N)" ; exit 1 ; }
+done
+echo "Results: $RESULTS_CSV"
+exit 0
@@ -1,11 +1,14 @@
 // custom-app.cpp
 
 #include "custom-app.hpp"
+#include "custom-profiler.hpp"
 #include "custom-utils.hpp"
 
 // NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/block-helpers.hpp"
 #include "ns3/ndnSIM/ndn-cxx/security/v2/certificate-fetcher-from-network.hpp"
 #include "ns3/ndnSIM/ndn-cxx/security/v2/certificate-fetcher-offline.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/verification-helpers.hpp"
 #include "ns3/ndnSIM/ndn-cxx/util/io.hpp"
 
 // NS3 / NDNSIM
@@ -14,8 +17,10 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
-// #include "ns3/boolean.h"
+#include "ns3/boolean.h"
+#include "ns3/energy-source-container.h"
 // #include "ns3/callback.h"
 // #include "ns3/double.h"
 // #include "ns3/integer.h"
@@ -27,6 +32,7 @@
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
 // system libs
+#include <algorithm>
 #include <fstream>
 #include <limits>
 #include <stdexcept> // for standard exception classes
@@ -113,6 +119,13 @@ namespace ns3 {
     // Necessary if you are planning to use ndn::AppHelper
     NS_OBJECT_ENSURE_REGISTERED(CustomApp);
 
+    const size_t CustomApp::MAX_BATCH_ROOTS = 64;
+    const uint32_t CustomApp::MAX_BATCH_ROOT_RETRIES = 3;
+    const uint32_t CustomApp::MAX_STALE_SCHEMA_REQUESTS = 3;
+
+    /// @brief finishCryptoJob events run so far (by every app), see finishCryptoJob()
+    static uint64_t g_cryptoJobEvents = 0;
+
     //////////////////////
     //     PUBLIC       //
     //////////////////////
@@ -139,9 +152,29 @@ namespace ns3 {
                             MakeNameAccessor(&CustomApp::m_signPrefix), MakeNameChecker())
               .AddAttribute("SchemaPrefix", "Trust Schema prefix", StringValue("/SCHEMA"),
                             MakeNameAccessor(&CustomApp::m_schemaPrefix), MakeNameChecker())
+              .AddAttribute("GroupKeyPrefix", "Zone group key prefix", StringValue("/GROUPKEY"),
+                            MakeNameAccessor(&CustomApp::m_groupKeyPrefix), MakeNameChecker())
+              .AddAttribute("GroupKey",
+                            "Sign content Data with the zone group HMAC key (trust anchor: distribute it, "
+                            "producer: fetch it after enrollment)",
+                            BooleanValue(false), MakeBooleanAccessor(&CustomApp::m_useGroupKey),
+                            MakeBooleanChecker())
+              .AddAttribute("SchemaFetchWindow", "Max number of SCHEMA segment Interests in flight",
+                            UintegerValue(4), MakeUintegerAccessor(&CustomApp::m_schemaFetchWindow),
+                            MakeUintegerChecker<uint32_t>(1))
+              .AddAttribute("BatchRootLifetime", "Lifetime of Interests for the Merkle root of batched Data",
+                            TimeValue(Seconds(2.0)), MakeTimeAccessor(&CustomApp::m_batchRootLifetime),
+                            MakeTimeChecker())
+              .AddAttribute("TrustedZones",
+                            "Other zones whose Data is accepted ('<zone>=<validatorConf>', space separated)",
+                            StringValue(""), MakeStringAccessor(&CustomApp::m_trustedZones),
+                            MakeStringChecker())
               .AddAttribute("ValidatorConf", "Validator config filename",
                             StringValue("./scratch/sim_bootsec/config/validator.conf"),
-                            MakeStringAccessor(&CustomApp::m_validatorConf), MakeStringChecker());
+                            MakeStringAccessor(&CustomApp::m_validatorConf), MakeStringChecker())
+              .AddTraceSource("CryptoTime", "Wall-clock time spent in a sign/verify operation",
+                              MakeTraceSourceAccessor(&CustomApp::m_cryptoTime),
+                              "ns3::ndn::CustomApp::CryptoTimeCallback");
       // .AddAttribute("IntMetrics",
       //               "Set of INT metrics to collect",
       //               IntMetricSetValue(),
@@ -157,22 +190,48 @@ namespace ns3 {
 
     CustomApp::CustomApp()
         : m_face_NDN_CXX(0), m_keyChain("pib-memory:", "tpm-memory:"),
-          m_signingInfo(::ndn::security::SigningInfo::SIGNER_TYPE_NULL), m_dataIsValid(false) {
+          m_signingInfo(::ndn::security::SigningInfo::SIGNER_TYPE_NULL), m_useGroupKey(false),
+          m_validationPolicy(nullptr),
+          m_cpuReady(Seconds(0)) {
       setSignValidityPeriod(365);
       setShouldValidateData(true);
     }
 
-    CustomApp::~CustomApp() {}
+    CustomApp::~CustomApp() {
+      // jobs still running when the simulation stopped
+      for(auto &job : m_cryptoJobs) {
+        job.wait();
+      }
+    }
 
     void CustomApp::StartApplication() {
       NS_LOG_FUNCTION_NOARGS();
       ndn::App::StartApplication();
 
+      // simulated CPU of the node (optional)
+      m_cpuModel = GetNode()->GetObject<CustomCpuModel>();
+      // crypto energy model of the node (optional), attached to one of its energy sources
+      auto energySources = GetNode()->GetObject<EnergySourceContainer>();
+      if(energySources != nullptr) {
+        for(auto it = energySources->Begin(); it != energySources->End() && m_energyModel == nullptr; ++it) {
+          auto models = (*it)->FindDeviceEnergyModels(CustomCryptoEnergyModel::GetTypeId());
+          if(models.GetN() > 0) {
+            m_energyModel = DynamicCast<CustomCryptoEnergyModel>(models.Get(0));
+          }
+        }
+      }
+
       // create ndn::Face to allow real-world application to interact inside ns3
       m_face_NDN_CXX = std::make_shared<::ndn::Face>();
 
-      // setup validatorConf
-      m_validator = std::make_shared<::ndn::security::ValidatorConfig>(
+      // setup validator (trust schema rules are indexed by name prefix)
+      auto policy = std::make_unique<CustomValidationPolicy>();
+      m_validationPolicy = policy.get();
+      // --> ASSUMPTION 01: zone group keys out-of-band distribution to validators (as the trust anchor .CERT)
+      policy->setGroupKeyLookup(
+          [](const ::ndn::Name &keyName) { return CustomSchemaStore::getInstance().readGroupKey(keyName); });
+      m_validator = std::make_shared<::ndn::security::v2::Validator>(
+          std::move(policy),
           std::make_unique<::ndn::security::v2::CertificateFetcherFromNetwork>(*m_face_NDN_CXX));
       m_validatorRoot = std::make_shared<::ndn::security::v2::validator_config::ConfigSection>();
       try {
@@ -185,6 +244,11 @@ namespace ns3 {
       // define schema prefixes /zoneA/SCHEMA/SUBSCRIBE
       m_schemaContentPrefix = m_schemaPrefix.deepCopy().append("CONTENT");
       m_schemaSubscribePrefix = m_schemaPrefix.deepCopy().append("SUBSCRIBE");
+      m_schemaFetches[m_schemaContentPrefix] = SchemaFetch();
+      restoreValidationRules();
+
+      // SCHEMA of other zones (out-of-band, as the own zone SCHEMA), then kept up to date by fetching
+      readTrustedZones();
     }
 
     // Processing when application is stopped
@@ -201,6 +265,7 @@ namespace ns3 {
 
     void CustomApp::OnInterest(std::shared_ptr<const ndn::Interest> interest) {
       ndn::App::OnInterest(interest); // forward call to perform app-level tracing
+      logEvent(CustomEventLog::INTEREST_IN);
 
       // Note that Interests send out by the app will not be sent back to the app !
       (isValidKeyName(interest->getName()) ? OnInterestKey(interest) : OnInterestContent(interest));
@@ -208,36 +273,77 @@ namespace ns3 {
 
     void CustomApp::OnData(std::shared_ptr<const ndn::Data> data) {
       ndn::App::OnData(data); // forward call to perform app-level tracing
+      logEvent(CustomEventLog::DATA_IN, data->getContent().value_size());
 
       // Note that datas send out by the app will not be sent back to the app !
       NS_LOG_DEBUG("Receiving Data packet: " << data->getName()
                                              << " - KeyLocator: " << data->getSignature().getKeyLocator());
-      if(m_shouldValidateData) {
-        NS_LOG_DEBUG("Validating Data ... ");
-        m_validator->validate(*data, MakeCallback(&CustomApp::OnDataValidated, this),
-                              MakeCallback(&CustomApp::OnDataValidationFailed, this));
+      if(isSchemaSegment(data->getName())) {
+        // checked against the (validated) SCHEMA manifest instead
+        OnDataSchemaSegment(data);
+      } else if(m_shouldValidateData && m_cpuModel != nullptr) {
+        // Data signature verification queued on the node CPU (certificate chain is not charged)
+        chargeEnergy(CustomCryptoEnergyModel::VERIFY, data->getSignature().getType());
+        Time done = m_cpuModel->execute(CustomCpuModel::VERIFY, data->getSignature().getType());
+        Simulator::Schedule(done - Simulator::Now(), &CustomApp::validateData, this, data);
+      } else if(m_shouldValidateData) {
+        chargeEnergy(CustomCryptoEnergyModel::VERIFY, data->getSignature().getType());
+        validateData(data);
       } else {
         NS_LOG_DEBUG("Validation SKIPPED");
-        (isValidCertificateName(data->getName()) ? OnDataCertificate(data) : OnDataContent(data));
+        ValidationContext ctx(false);
+        (isValidCertificateName(data->getName()) ? OnDataCertificate(data, ctx) : OnDataContent(data, ctx));
+      }
+    }
+
+    void CustomApp::OnNack(std::shared_ptr<const ::ndn::lp::Nack> nack) {
+      ndn::App::OnNack(nack); // forward call to perform app-level tracing
+      logEvent(CustomEventLog::NACK_IN, static_cast<uint64_t>(nack->getReason()));
+
+      // BATCH root not available (yet): retry now instead of waiting for the Interest lifetime
+      auto &name = nack->getInterest().getName();
+      if(m_batchPending.count(name) > 0) {
+        auto nameStr = name.toUri();
+        Simulator::Cancel(m_sendEvents[nameStr]);
+        retransmitBatchRoot(name);
       }
     }
 
     void CustomApp::OnInterestKey(std::shared_ptr<const ndn::Interest> interest) {}
     void CustomApp::OnInterestContent(std::shared_ptr<const ndn::Interest> interest) {}
 
-    void CustomApp::OnDataCertificate(std::shared_ptr<const ndn::Data> data) {}
-    void CustomApp::OnDataContent(std::shared_ptr<const ndn::Data> data) {}
-
-    void CustomApp::OnDataValidated(const ndn::Data &data) {
-      NS_LOG_FUNCTION_NOARGS();
-      m_dataIsValid = true;
-      auto dataPtr = std::make_shared<const ndn::Data>(data);
-      (isValidCertificateName(dataPtr->getName()) ? OnDataCertificate(dataPtr) : OnDataContent(dataPtr));
+    void CustomApp::OnDataCertificate(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) {}
+    void CustomApp::OnDataContent(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) {}
+
+    void CustomApp::OnDataValidated(std::shared_ptr<const ndn::Data> data) {
+      NS_LOG_FUNCTION(data->getName());
+      logEvent(CustomEventLog::VALIDATED);
+      if(m_batchPending.count(data->getName()) > 0) {
+        // Merkle root of batch-signed Data: validated once, then hashes only for each Data of the batch
+        auto &content = data->getContent();
+        auto root = std::make_shared<::ndn::Buffer>(content.value(), content.value_size());
+        m_batchRoots[data->getName()] = root;
+        m_batchRootOrder.push_back(data->getName());
+        if(m_batchRootOrder.size() > MAX_BATCH_ROOTS) {
+          m_batchRoots.erase(m_batchRootOrder.front());
+          m_batchRootOrder.pop_front();
+        }
+        for(const auto &batchedData : takeBatchPending(data->getName())) {
+          verifyBatchedData(batchedData, *root);
+        }
+        return;
+      }
+      ValidationContext ctx(true);
+      (isValidCertificateName(data->getName()) ? OnDataCertificate(data, ctx) : OnDataContent(data, ctx));
     }
-    void CustomApp::OnDataValidationFailed(const ndn::Data &data,
+    void CustomApp::OnDataValidationFailed(std::shared_ptr<const ndn::Data> data,
                                            const ::ndn::security::v2::ValidationError &error) {
-      NS_LOG_FUNCTION(data.getName());
-      m_dataIsValid = false;
+      NS_LOG_FUNCTION(data->getName() << error);
+      logEvent(CustomEventLog::VALIDATION_FAILED, error.getCode());
+      // the whole batch fails with its root
+      for(const auto &batchedData : takeBatchPending(data->getName())) {
+        OnDataValidationFailed(batchedData, error);
+      }
       printValidationRules();
     }
 
@@ -252,6 +358,14 @@ namespace ns3 {
       m_signingInfo.setSignatureInfo(signatureInfo);
     }
 
+    /// @brief freshness of Data that stays valid as long as the signatures of this app (cached until then)
+    ::ndn::time::milliseconds CustomApp::getValidityFreshness() {
+      auto notAfter = m_signingInfo.getSignatureInfo().getValidityPeriod().getPeriod().second;
+      auto now = ::ndn::time::system_clock::now();
+      return (notAfter > now ? ::ndn::time::duration_cast<::ndn::time::milliseconds>(notAfter - now)
+                             : ::ndn::time::milliseconds(0));
+    }
+
     void CustomApp::setShouldValidateData(bool validate) { m_shouldValidateData = validate; }
     bool CustomApp::getShouldValidateData() { return m_shouldValidateData; }
 
@@ -260,8 +374,10 @@ namespace ns3 {
       try {
         // Ler o arquivo INFO
         NS_LOG_INFO("Reading trust schema from file '" << m_validatorConf << "' ... ");
-        boost::property_tree::read_info(m_validatorConf, *m_validatorRoot);
-        reloadValidationRules();
+        // parsed once per file and shared among apps
+        auto schema = CustomSchemaStore::getInstance().readSchema(m_validatorConf);
+        *m_validatorRoot = *schema.rules;
+        reloadValidationRules(schema.index);
       } catch(const std::exception &e) {
         throw std::runtime_error("Failed to load validation rules file='" + m_validatorConf +
                                  "' - Error=" + e.what());
@@ -273,22 +389,145 @@ namespace ns3 {
       try {
         NS_LOG_INFO("Reading trust schema from Data packet '" << data->getName() << "'... ");
         auto &contentBlock = data->getContent();
-        std::string contentStr(contentBlock.value_begin(), contentBlock.value_end());
-        std::stringstream inputStream(contentStr);
-        NS_LOG_INFO("InputStream: \n" << inputStream.str());
-        boost::property_tree::read_info(inputStream, *m_validatorRoot);
-        reloadValidationRules();
+        loadValidationRules(m_schemaContentPrefix, contentBlock.value(), contentBlock.value_size());
       } catch(const std::exception &e) {
         throw std::runtime_error("Failed load validation rules from '" + data->getName().toUri() +
                                  "' - Error=" + e.what());
       }
     }
 
-    /// @brief Write Validation Rules from memory into a file
+    /// @brief read the SCHEMA of every zone listed in m_trustedZones ("/zoneB=<file> /zoneC=<file>")
+    void CustomApp::readTrustedZones() {
+      std::istringstream stream(m_trustedZones);
+      std::string entry;
+      while(stream >> entry) {
+        auto pos = entry.find('=');
+        if(pos == std::string::npos) {
+          throw std::runtime_error("Failed to parse TrustedZones entry='" + entry + "'");
+        }
+        ::ndn::Name zone(entry.substr(0, pos));
+        auto filename = entry.substr(pos + 1);
+        try {
+          NS_LOG_INFO("Reading trust schema of zone '" << zone << "' from file '" << filename << "' ... ");
+          auto contentPrefix = zone.append("SCHEMA").append("CONTENT");
+          m_trustedSchemas[contentPrefix] = *CustomSchemaStore::getInstance().readSchema(filename).rules;
+          m_schemaFetches[contentPrefix] = SchemaFetch();
+        } catch(const std::exception &e) {
+          throw std::runtime_error("Failed to load validation rules file='" + filename +
+                                   "' - Error=" + e.what());
+        }
+      }
+      if(!m_trustedSchemas.empty()) {
+        reloadValidationRules();
+      }
+    }
+
+    /// @brief fetch the SCHEMA segments listed in a (validated) SCHEMA/CONTENT manifest
+    void CustomApp::fetchValidationRules(std::shared_ptr<const ndn::Data> manifestData) {
+      try {
+        auto it = m_schemaFetches.find(manifestData->getName());
+        if(it == m_schemaFetches.end()) {
+          throw std::runtime_error("unknown SCHEMA prefix");
+        }
+        auto &fetch = it->second;
+        auto manifest = CustomSchemaTlv::decodeManifest(manifestData->getContent().blockFromValue());
+        NS_LOG_INFO("Received SCHEMA manifest '" << it->first << "' version=" << manifest.version
+                                                 << " - segments=" << manifest.digests.size());
+        // (trust anchors of the zone may serve different versions of the same generation for a while)
+        auto generation = CustomSchemaTlv::getGeneration(manifest.version);
+        if(generation >= CustomSchemaTlv::getGeneration(fetch.announced)) {
+          fetch.staleRequests = 0;
+        } else if(fetch.staleRequests < MAX_STALE_SCHEMA_REQUESTS) {
+          // cached copy older than the announced generation: ask again once it is no longer fresh
+          fetch.staleRequests++;
+          auto freshness = manifestData->getFreshnessPeriod().count();
+          Simulator::Schedule(MilliSeconds(freshness + 1), &CustomApp::requestSchemaManifest, this,
+                              it->first);
+        }
+        if(manifest.version <= fetch.version) {
+          return; // already loaded
+        } else if(manifest.digests.empty()) {
+          throw std::runtime_error("manifest has no segments");
+        }
+        if(manifest.version != fetch.manifest.version) {
+          // (re)start fetching with the latest version
+          fetch.manifest = manifest;
+          fetch.segments.assign(manifest.digests.size(), nullptr);
+          fetch.next = 0;
+          fetch.received = 0;
+        }
+        // segments in flight are retransmitted by their own timer (retransmitSchemaSegment)
+        while(fetch.next < fetch.segments.size() && fetch.next - fetch.received < m_schemaFetchWindow) {
+          sendSchemaSegmentInterest(it->first, fetch.next++);
+        }
+      } catch(const std::exception &e) {
+        throw std::runtime_error("Failed to fetch validation rules from '" + manifestData->getName().toUri() +
+                                 "' - Error=" + e.what());
+      }
+    }
+
+    /// @brief request the current SCHEMA/CONTENT manifest of the own zone and of every trusted zone
+    void CustomApp::requestValidationRules() {
+      for(const auto &pairPrefixFetch : m_schemaFetches) {
+        requestSchemaManifest(pairPrefixFetch.first);
+      }
+    }
+
+    /// @brief warm start: SCHEMA of the own zone from the loaded snapshot (false if not in the snapshot)
+    bool CustomApp::restoreValidationRules() {
+      auto schema = CustomSnapshot::getInstance().getSchema(m_schemaContentPrefix);
+      if(schema == nullptr) {
+        return false;
+      }
+      NS_LOG_INFO("Restoring trust schema version=" << schema->version << " from snapshot ...");
+      loadValidationRules(m_schemaContentPrefix, schema->payload.data(), schema->payload.size());
+      m_schemaFetches[m_schemaContentPrefix].version = schema->version;
+      return true;
+    }
+
+    void CustomApp::requestSchemaManifest(const ::ndn::Name &contentPrefix) {
+      NS_LOG_INFO("Sending SCHEMA content Interest for '" << contentPrefix << "' ... ");
+      InterestOptions opts;
+      opts.canBePrefix = false;
+      opts.mustBeFresh = true;
+      sendInterest(contentPrefix, m_schemaSubscribeLifetime, opts);
+    }
+
+    /// @brief handle SCHEMA/CONTENT manifests and SCHEMA/SUBSCRIBE notifications of any known zone
+    /// @return true if data was a SCHEMA packet
+    bool CustomApp::OnDataSchema(std::shared_ptr<const ndn::Data> data) {
+      auto &name = data->getName();
+      for(const auto &pairPrefixFetch : m_schemaFetches) {
+        auto &contentPrefix = pairPrefixFetch.first;
+        // /<zone>/SCHEMA/CONTENT => /<zone>/SCHEMA/SUBSCRIBE
+        auto subscribePrefix = contentPrefix.getPrefix(-1).append("SUBSCRIBE");
+        if(contentPrefix == name) {
+          fetchValidationRules(data);
+          return true;
+        } else if(subscribePrefix.isPrefixOf(name)) {
+          auto &content = data->getContent();
+          if(content.value_size() > 0) {
+            try {
+              auto version = ::ndn::encoding::readNonNegativeInteger(content.blockFromValue());
+              auto &fetch = m_schemaFetches[contentPrefix];
+              fetch.announced = std::max(fetch.announced, version);
+            } catch(const ::ndn::tlv::Error &e) {
+              NS_LOG_WARN("Dropping SCHEMA notification '" << name << "' - Error=" << e.what());
+              return true;
+            }
+          }
+          requestSchemaManifest(contentPrefix);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// @brief Write Validation Rules from memory into a file (asynchronously)
     void CustomApp::writeValidationRules() {
       try {
         NS_LOG_INFO("Write trust schema into file '" << m_validatorConf << "'... ");
-        ::boost::property_tree::write_info(m_validatorConf, *m_validatorRoot);
+        CustomSchemaStore::getInstance().writeSchema(m_validatorConf, *m_validatorRoot);
       } catch(const std::exception &e) {
         throw std::runtime_error("Failed to write validation rules into file='" + m_validatorConf +
                                  "' - Error=" + e.what());
@@ -304,37 +543,56 @@ namespace ns3 {
     /// @brief get a copy of the validation rules stored in memory
     /// @return copy of validation rules (string format)
     std::string CustomApp::getValidationRules() {
+      CUSTOM_PROFILE_SCOPE("write_info(schema)");
       std::stringstream stream;
       ::boost::property_tree::write_info(stream, *m_validatorRoot);
       return stream.str();
     }
 
+    /// @brief get a copy of the validation rules stored in memory
+    /// @return copy of validation rules (binary TLV format)
+    ::ndn::Block CustomApp::getValidationRulesBlock() { return CustomSchemaTlv::encode(*m_validatorRoot); }
+
     void CustomApp::addValidationRule(std::string dataRegex, std::string keyLocatorRegex) {
       try {
         NS_LOG_FUNCTION("data=" << dataRegex << " , keylocator=" << keyLocatorRegex);
-        ::ndn::security::v2::validator_config::ConfigSection rule;
-        rule.put("id", dataRegex);
-        rule.put("for", "data");
-        rule.put("filter.type", "name");
-        rule.put("filter.regex", dataRegex);
-        rule.put("checker.type", "customized");
-        rule.put("checker.sig-type", "rsa-sha256");
-        rule.put("checker.key-locator.type", "name");
-        rule.put("checker.key-locator.regex", keyLocatorRegex);
-
-        m_validatorRoot->push_front(std::make_pair("rule", rule));
-        reloadValidationRules();
+        addValidationRule(CustomSchemaRules::createValidationRule(dataRegex, keyLocatorRegex));
       } catch(const std::exception &e) {
         throw std::runtime_error("Failed add validation rule for data=''" + dataRegex + "' , keyLocator='" +
                                  keyLocatorRegex + "' - Error=" + e.what());
       }
     }
 
+    void CustomApp::addValidationRule(const ::ndn::security::v2::validator_config::ConfigSection &rule) {
+      NS_LOG_FUNCTION(rule.get<std::string>("id", ""));
+      m_validatorRoot->push_front(std::make_pair("rule", rule));
+      reloadValidationRules();
+    }
+
+    /// @brief add a rule at a given position of the trust schema (first match wins)
+    void CustomApp::insertValidationRule(size_t position,
+                                         const ::ndn::security::v2::validator_config::ConfigSection &rule) {
+      NS_LOG_FUNCTION(position << rule.get<std::string>("id", ""));
+      auto it = m_validatorRoot->begin();
+      std::advance(it, std::min(position, m_validatorRoot->size()));
+      m_validatorRoot->insert(it, std::make_pair("rule", rule));
+      reloadValidationRules();
+    }
+
+    /// @brief replace (or add) a top-level section of the trust schema, e.g. "membership"
+    void CustomApp::setValidationSection(
+        const std::string &key, const ::ndn::security::v2::validator_config::ConfigSection &section) {
+      NS_LOG_FUNCTION(key);
+      m_validatorRoot->erase(key);
+      m_validatorRoot->push_back(std::make_pair(key, section));
+      reloadValidationRules();
+    }
+
     void CustomApp::addTrustAnchor(std::string filename) {
       try {
         NS_LOG_FUNCTION(filename);
 
-        if(!::utils::fileExists(filename)) {
+        if(!CustomSchemaStore::getInstance().exists(filename)) {
           throw std::runtime_error("file '" + filename + "' does not exist");
         }
 
@@ -351,14 +609,6 @@ namespace ns3 {
       }
     }
 
-    std::string CustomApp::getValidationRegex(const ::ndn::Name &prefix) {
-      std::stringstream res;
-      for(auto &item : prefix) {
-        res << "<" << item << ">";
-      }
-      return res.str();
-    }
-
     void CustomApp::sendInterest(::ndn::Name name, ns3::Time lifeTime, const InterestOptions &opts) {
       sendInterest(name.toUri(), lifeTime, opts);
     }
@@ -381,23 +631,313 @@ namespace ns3 {
       // to create real wire encoding
       interest->wireEncode();
 
+      if(m_cpuReady > Simulator::Now()) {
+        // wait for the sign operations queued on the node CPU
+        Simulator::Schedule(m_cpuReady - Simulator::Now(), &CustomApp::transmitInterest, this, interest);
+      } else {
+        transmitInterest(interest);
+      }
+    }
+
+    void CustomApp::transmitInterest(std::shared_ptr<ndn::Interest> interest) {
+      if(!m_active) {
+        return;
+      }
       // Call trace (for logging purposes), send interest, schedule next interests
       NS_LOG_DEBUG("Sending Interest packet: " << *interest);
       m_transmittedInterests(interest, this, m_face);
+      logEvent(CustomEventLog::INTEREST_OUT);
       m_appLink->onReceiveInterest(*interest);
     }
 
+    void CustomApp::sign(ndn::Data &data, const ::ndn::security::SigningInfo &signingInfo) {
+      CUSTOM_PROFILE_SCOPE("KeyChain::sign(Data)");
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
+      auto start = std::chrono::steady_clock::now();
+      m_keyChain.sign(data, signingInfo);
+      traceCryptoTime(start);
+      chargeCpu(CustomCpuModel::SIGN, data.getSignature().getType());
+    }
+
+    void CustomApp::sign(ndn::Interest &interest, const ::ndn::security::SigningInfo &signingInfo) {
+      CUSTOM_PROFILE_SCOPE("KeyChain::sign(Interest)");
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
+      auto start = std::chrono::steady_clock::now();
+      m_keyChain.sign(interest, signingInfo);
+      traceCryptoTime(start);
+      chargeCpu(CustomCpuModel::SIGN, getSignatureType(interest));
+    }
+
+    /// @brief sign the Data on CustomCryptoPool, onSigned runs (on the simulator thread) at the simulated
+    ///        time the signature completes: now, or when the node CPU served it (see CustomCpuModel)
+    void CustomApp::signAsync(std::shared_ptr<ndn::Data> data,
+                              const ::ndn::security::SigningInfo &signingInfo,
+                              std::function<void()> onSigned) {
+      signAsync(std::vector<std::shared_ptr<ndn::Data>>{data}, signingInfo, onSigned);
+    }
+
+    /// @brief sign several Data in order in one CustomCryptoPool job, beforeSign(i) runs (on the worker) just
+    ///        before Data i is signed, e.g. to put the signed Data i-1 in its content
+    void CustomApp::signAsync(std::vector<std::shared_ptr<ndn::Data>> datas,
+                              const ::ndn::security::SigningInfo &signingInfo, std::function<void()> onSigned,
+                              std::function<void(size_t)> beforeSign) {
+      ::ndn::SignatureInfo sigInfo;
+      auto privateKey = getPrivateKey(signingInfo, sigInfo);
+      if(privateKey == nullptr) {
+        // digest or HMAC signature (whatever the number of worker threads): signed inline
+        for(size_t i = 0; i < datas.size(); i++) {
+          if(beforeSign) {
+            beforeSign(i);
+          }
+          sign(*datas[i], signingInfo);
+        }
+        onSigned();
+        return;
+      }
+      for(size_t i = 0; i < datas.size(); i++) {
+        chargeCpu(CustomCpuModel::SIGN, sigInfo.getSignatureType());
+      }
+      Time completion = std::max(m_cpuReady, Simulator::Now());
+
+      auto job = submitCryptoJob([datas, sigInfo, privateKey, beforeSign] {
+        CUSTOM_PROFILE_SCOPE("CustomCryptoPool::signData");
+        for(size_t i = 0; i < datas.size(); i++) {
+          if(beforeSign) {
+            beforeSign(i);
+          }
+          datas[i]->setSignature(::ndn::Signature(sigInfo));
+          CustomCryptoPool::signData(*datas[i], *privateKey);
+        }
+      });
+      Simulator::Schedule(completion - Simulator::Now(), &CustomApp::finishCryptoJob, this, job, onSigned,
+                          Simulator::GetEventCount(), g_cryptoJobEvents);
+    }
+
+    /// @brief verify the signature of a Data signed by an already trusted certificate on CustomCryptoPool,
+    ///        then OnDataValidated / OnDataValidationFailed (on the simulator thread)
+    void CustomApp::verifyAsync(std::shared_ptr<const ndn::Data> data,
+                                const ::ndn::security::v2::Certificate &cert) {
+      auto valid = std::make_shared<bool>(false);
+      auto job = submitCryptoJob([data, cert, valid] {
+        CUSTOM_PROFILE_SCOPE("verifySignature(Data)");
+        *valid = ::ndn::security::verifySignature(*data, cert);
+      });
+      auto keyName = cert.getKeyName();
+      std::function<void()> onVerified = [this, data, valid, keyName] {
+        if(*valid) {
+          OnDataValidated(data);
+        } else {
+          OnDataValidationFailed(data, {::ndn::security::v2::ValidationError::INVALID_SIGNATURE,
+                                        "Signature does not match key `" + keyName.toUri() + "`"});
+        }
+      };
+      Simulator::ScheduleNow(&CustomApp::finishCryptoJob, this, job, onVerified, Simulator::GetEventCount(),
+                             g_cryptoJobEvents);
+    }
+
+    /// @brief timed CustomCryptoPool job, handed to the worker threads at once if there are any
+    std::shared_ptr<CustomApp::CryptoJob> CustomApp::submitCryptoJob(std::function<void()> work) {
+      auto job = std::make_shared<CryptoJob>();
+      auto wallTime = std::make_shared<std::chrono::nanoseconds>(0);
+      job->wallTime = wallTime;
+      job->work = [work, wallTime] {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        *wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+      };
+      auto &pool = CustomCryptoPool::getInstance();
+      if(pool.getThreads() > 0) {
+        job->future = pool.submit(job->work);
+        m_cryptoJobs.push_back(job->future);
+      }
+      return job;
+    }
+
+    /// @brief end of a CustomCryptoPool job at its simulated completion time. It waits (rescheduled at the
+    ///        same time) until no other kind of event is left at this time, so the jobs of a timestamp (from
+    ///        every app) run together on the workers before the simulator thread blocks on them. Only event
+    ///        counts decide, and the same events run with or without worker threads (the job then runs
+    ///        here), so the event order does not depend on the number of threads.
+    void CustomApp::finishCryptoJob(std::shared_ptr<CryptoJob> job, std::function<void()> onDone,
+                                    uint64_t events, uint64_t jobEvents) {
+      g_cryptoJobEvents++;
+      // events run since this one was scheduled, other than finishCryptoJob (itself included)
+      uint64_t others = (Simulator::GetEventCount() - events) - (g_cryptoJobEvents - jobEvents);
+      if(others > 0) {
+        Simulator::ScheduleNow(&CustomApp::finishCryptoJob, this, job, onDone, Simulator::GetEventCount(),
+                               g_cryptoJobEvents);
+        return;
+      }
+      if(!job->future.valid()) {
+        // no worker threads: run on the simulator thread
+        job->future = CustomCryptoPool::getInstance().submit(job->work);
+      }
+      job->future.get(); // wait for the worker thread (rethrows crypto errors)
+      auto isDone = [](const std::shared_future<void> &other) {
+        return other.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+      };
+      m_cryptoJobs.erase(std::remove_if(m_cryptoJobs.begin(), m_cryptoJobs.end(), isDone),
+                         m_cryptoJobs.end());
+      m_cryptoTime(this, NanoSeconds(job->wallTime->count()));
+      onDone();
+    }
+
+    /// @brief fire CryptoTime with the wall-clock time elapsed since start
+    void CustomApp::traceCryptoTime(std::chrono::steady_clock::time_point start) {
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      m_cryptoTime(this, NanoSeconds(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    /// @brief queue an operation on the node CPU, the next packets sent wait for it
+    void CustomApp::chargeCpu(CustomCpuModel::Operation op, uint32_t sigType) {
+      if(m_cpuModel != nullptr) {
+        m_cpuReady = std::max(m_cpuReady, m_cpuModel->execute(op, sigType));
+      }
+      chargeEnergy((op == CustomCpuModel::SIGN ? CustomCryptoEnergyModel::SIGN
+                                               : CustomCryptoEnergyModel::VERIFY),
+                   sigType);
+    }
+
+    /// @brief draw the energy of an operation from the node energy source (over its CPU service time)
+    void CustomApp::chargeEnergy(CustomCryptoEnergyModel::Operation op, uint32_t sigType) {
+      if(m_energyModel == nullptr) {
+        return;
+      }
+      Time duration = Seconds(0);
+      if(m_cpuModel != nullptr && op != CustomCryptoEnergyModel::KEYGEN) {
+        duration = m_cpuModel->getCost((op == CustomCryptoEnergyModel::SIGN ? CustomCpuModel::SIGN
+                                                                             : CustomCpuModel::VERIFY),
+                                       sigType);
+      }
+      m_energyModel->charge(op, sigType, duration);
+    }
+
+    /// @brief structured event of the app (no-op unless the CustomEventLog is open)
+    void CustomApp::logEvent(CustomEventLog::Type type, uint64_t value) {
+      CustomEventLog::getInstance().record(Simulator::Now(), GetNode()->GetId(), type, value);
+    }
+
+    /// @brief signature type of a signed Interest (0 if not signed)
+    uint32_t CustomApp::getSignatureType(const ndn::Interest &interest) {
+      auto &name = interest.getName();
+      if(name.size() < ::ndn::signed_interest::MIN_SIZE) {
+        return 0;
+      }
+      try {
+        auto sigInfo = name[::ndn::signed_interest::POS_SIG_INFO].blockFromValue();
+        return ::ndn::SignatureInfo(sigInfo).getSignatureType();
+      } catch(const ::ndn::tlv::Error &e) {
+        return 0;
+      }
+    }
+
+    /// @brief signature type KeyChain::sign produces with the signing info (0 if unknown)
+    uint32_t CustomApp::getSignatureType(const ::ndn::security::SigningInfo &signingInfo) {
+      using ::ndn::security::SigningInfo;
+      if(signingInfo.getSignerType() == SigningInfo::SIGNER_TYPE_SHA256) {
+        return ::ndn::tlv::DigestSha256;
+      }
+      try {
+        auto key = getSigningKey(signingInfo);
+        return (key.getKeyType() == ::ndn::KeyType::EC ? ::ndn::tlv::SignatureSha256WithEcdsa
+                                                         : ::ndn::tlv::SignatureSha256WithRsa);
+      } catch(const ::ndn::security::pib::Pib::Error &e) {
+        return 0;
+      }
+    }
+
+    /// @brief key of m_keyChain that signs with signingInfo (SIGNER_TYPE_ID/KEY/CERT/NULL), throws Pib::Error
+    ::ndn::security::pib::Key CustomApp::getSigningKey(const ::ndn::security::SigningInfo &signingInfo) {
+      using ::ndn::security::SigningInfo;
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
+      auto &pib = m_keyChain.getPib();
+      auto &signer = signingInfo.getSignerName();
+      switch(signingInfo.getSignerType()) {
+        case SigningInfo::SIGNER_TYPE_ID:
+          return pib.getIdentity(signer).getDefaultKey();
+        case SigningInfo::SIGNER_TYPE_KEY:
+          return pib.getIdentity(::ndn::security::v2::extractIdentityFromKeyName(signer)).getKey(signer);
+        case SigningInfo::SIGNER_TYPE_CERT: {
+          auto keyName = ::ndn::security::v2::extractKeyNameFromCertName(signer);
+          return pib.getIdentity(::ndn::security::v2::extractIdentityFromKeyName(keyName)).getKey(keyName);
+        }
+        default: // SIGNER_TYPE_NULL
+          return pib.getDefaultIdentity().getDefaultKey();
+      }
+    }
+
+    /// @brief private key handle for CustomCryptoPool jobs (exported once per key) and the SignatureInfo
+    ///        KeyChain::sign would use (KeyLocator = key name), nullptr if signingInfo has no RSA/ECDSA key
+    std::shared_ptr<const ::ndn::security::transform::PrivateKey>
+    CustomApp::getPrivateKey(const ::ndn::security::SigningInfo &signingInfo, ::ndn::SignatureInfo &sigInfo) {
+      if(signingInfo.getSignerType() == ::ndn::security::SigningInfo::SIGNER_TYPE_SHA256 ||
+         signingInfo.getSignerType() == ::ndn::security::SigningInfo::SIGNER_TYPE_HMAC) {
+        return nullptr;
+      }
+      try {
+        auto key = getSigningKey(signingInfo);
+        auto &privateKey = m_privateKeys[key.getName()];
+        if(privateKey == nullptr) {
+          std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
+          privateKey = CustomCryptoPool::exportPrivateKey(m_keyChain, key);
+        }
+        sigInfo = signingInfo.getSignatureInfo();
+        sigInfo.setSignatureType(key.getKeyType() == ::ndn::KeyType::EC ? ::ndn::tlv::SignatureSha256WithEcdsa
+                                                                        : ::ndn::tlv::SignatureSha256WithRsa);
+        sigInfo.setKeyLocator(::ndn::KeyLocator(key.getName()));
+        return privateKey;
+      } catch(const std::exception &e) {
+        NS_LOG_WARN("Signing inline, no private key for the crypto pool - Error=" << e.what());
+        return nullptr;
+      }
+    }
+
     void CustomApp::sendData(std::shared_ptr<ndn::Data> data) {
       // to create real wire encoding
       data->wireEncode();
 
+      if(m_cpuReady > Simulator::Now()) {
+        // wait for the sign operations queued on the node CPU
+        Simulator::Schedule(m_cpuReady - Simulator::Now(), &CustomApp::transmitData, this, data);
+      } else {
+        transmitData(data);
+      }
+    }
+
+    void CustomApp::transmitData(std::shared_ptr<ndn::Data> data) {
+      if(!m_active) {
+        return;
+      }
       // Call trace (for logging purposes), send data packet
       NS_LOG_INFO("Sending Data packet: " << data->getName());
       // NS_LOG_INFO("Signature: " << data->getSignature().getSignatureInfo());
       m_transmittedDatas(data, this, m_face);
+      logEvent(CustomEventLog::DATA_OUT, data->getContent().value_size());
       m_appLink->onReceiveData(*data);
     }
 
+    /// @brief bundle the signer certificate chain with the Data (before signing it), so validators do not
+    ///        need to fetch it. The trust anchor is not attached (validators already have it).
+    void CustomApp::attachCertificate(ndn::Data &data, const ::ndn::security::v2::Certificate &cert) {
+      ::ndn::Block bundle(CustomSchemaTlv::CertificateBundle);
+      bundle.push_back(cert.wireEncode());
+      bundle.encode();
+      auto metaInfo = data.getMetaInfo();
+      metaInfo.removeAppMetaInfo(CustomSchemaTlv::CertificateBundle);
+      metaInfo.addAppMetaInfo(bundle);
+      data.setMetaInfo(metaInfo);
+    }
+
+    void CustomApp::sendNack(std::shared_ptr<const ndn::Interest> interest, ::ndn::lp::NackReason reason) {
+      ::ndn::lp::Nack nack(*interest);
+      nack.setReason(reason);
+
+      NS_LOG_INFO("Sending Nack packet: " << interest->getName() << " - Reason: " << reason);
+      logEvent(CustomEventLog::NACK_OUT, static_cast<uint64_t>(reason));
+      m_appLink->onReceiveNack(nack);
+    }
+
     void CustomApp::sendCertificate(std::shared_ptr<const ndn::Interest> interest, const DataOptions &opts) {
       sendCertificate(interest->getName(), opts);
     }
@@ -405,6 +945,7 @@ namespace ns3 {
     void CustomApp::sendCertificate(const ndn::Name &keyName, const DataOptions &opts) {
       NS_LOG_FUNCTION(keyName);
 
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
       try {
         auto identity =
             m_keyChain.getPib().getIdentity(::ndn::security::v2::extractIdentityFromKeyName(keyName));
@@ -419,28 +960,39 @@ namespace ns3 {
     }
 
     void CustomApp::sendCertificate(std::shared_ptr<::ndn::security::v2::Certificate> cert) {
-      // to create real wire encoding
-      cert->wireEncode();
-
       // LOGGING
       NS_LOG_INFO("Sending Certificate packet: " << cert->getName());
       NS_LOG_INFO("Signature: " << cert->getSignature().getSignatureInfo());
 
-      // Call trace (for logging purposes) - no way to log certificate
-      // issuing below m_transmittedDatas(cert, this, m_face);
-      m_appLink->onReceiveData(*cert);
+      // a Certificate is a Data: traced (TransmittedDatas, event log) and sent as any other Data
+      sendData(cert);
     }
 
-    const ::ndn::security::v2::Certificate &CustomApp::createCertificate(const ndn::Name &prefix) {
+    const ::ndn::security::v2::Certificate &CustomApp::createCertificate(const ndn::Name &prefix,
+                                                                         const ::ndn::KeyParams &params) {
+      CUSTOM_PROFILE_SCOPE("KeyChain::createIdentity");
       NS_LOG_INFO("Creating certificate/identity for '" << prefix << "' ...");
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
       try {
         // clear keychain from any identical identities
         m_keyChain.deleteIdentity(m_keyChain.getPib().getIdentity(prefix));
       } catch(::ndn::security::pib::Pib::Error &e) {
         // no identity found, proceed with the new identity creation
       }
+      // warm start: KEY and (signed) certificate of the previous run
+      auto safeBag = CustomSnapshot::getInstance().getIdentity(prefix);
+      if(safeBag != nullptr) {
+        NS_LOG_INFO("Restoring certificate/identity for '" << prefix << "' from snapshot ...");
+        auto &password = CustomSnapshot::PASSWORD;
+        m_keyChain.importSafeBag(*safeBag, password.c_str(), password.size());
+        return m_keyChain.getPib().getIdentity(prefix).getDefaultKey().getDefaultCertificate();
+      }
       // create identity and certificates
-      auto identity = m_keyChain.createIdentity(prefix);
+      auto identity = m_keyChain.createIdentity(prefix, params);
+      // key pair generation and self-signature
+      auto sigType = CustomCryptoEnergyModel::getKeySignatureType(params.getKeyType());
+      chargeEnergy(CustomCryptoEnergyModel::KEYGEN, sigType);
+      chargeEnergy(CustomCryptoEnergyModel::SIGN, sigType);
       auto &key = identity.getDefaultKey();
       return key.getDefaultCertificate();
     }
@@ -449,6 +1001,7 @@ namespace ns3 {
       NS_LOG_FUNCTION(cert.getName());
       // add certificate to key chain
       auto keyName = cert.getKeyName();
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
       try {
         auto identity =
             m_keyChain.getPib().getIdentity(::ndn::security::v2::extractIdentityFromKeyName(keyName));
@@ -463,7 +1016,22 @@ namespace ns3 {
       }
     }
 
+    void CustomApp::writeSnapshot(CustomSnapshot &snapshot) {
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
+      auto &password = CustomSnapshot::PASSWORD;
+      for(const auto &identity : m_keyChain.getPib().getIdentities()) {
+        try {
+          auto cert = identity.getDefaultKey().getDefaultCertificate();
+          snapshot.setIdentity(identity.getName(),
+                               m_keyChain.exportSafeBag(cert, password.c_str(), password.size()));
+        } catch(::ndn::security::pib::Pib::Error &e) {
+          NS_LOG_WARN("Skipping identity '" << identity.getName() << "' - no default certificate");
+        }
+      }
+    }
+
     void CustomApp::printKeyChain() {
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
       for(auto identity : m_keyChain.getPib().getIdentities()) {
         NS_LOG_DEBUG("Identity: " << identity.getName());
         for(auto key : identity.getKeys()) {
@@ -480,7 +1048,6 @@ namespace ns3 {
       NS_LOG_INFO("\n" << getValidationRules());
     }
 
-    bool CustomApp::isDataValid() { return m_dataIsValid; }
 
     bool CustomApp::hasEvent(std::string &name) { return (m_sendEvents.find(name) != m_sendEvents.end()); }
 
@@ -503,7 +1070,11 @@ namespace ns3 {
       InterestOptions opts;
       opts.canBePrefix = false;
       opts.mustBeFresh = true;
-      sendInterest(m_schemaSubscribePrefix, m_schemaSubscribeLifetime, opts);
+      for(const auto &pairPrefixFetch : m_schemaFetches) {
+        // /<zone>/SCHEMA/CONTENT => /<zone>/SCHEMA/SUBSCRIBE
+        auto subscribePrefix = pairPrefixFetch.first.getPrefix(-1).append("SUBSCRIBE");
+        sendInterest(subscribePrefix, m_schemaSubscribeLifetime, opts);
+      }
       scheduleSubscribeSchema();
     }
 
@@ -511,15 +1082,307 @@ namespace ns3 {
     //     PRIVATE
     //////////////////////
 
+    /// @brief replace the validation rules of a zone with a SCHEMA payload (binary TLV or INFO text)
+    /// @param contentPrefix SCHEMA/CONTENT prefix of the zone (own zone or trusted zone)
+    void CustomApp::loadValidationRules(const ::ndn::Name &contentPrefix, const uint8_t *buf, size_t size) {
+      auto &rules =
+          (contentPrefix == m_schemaContentPrefix ? *m_validatorRoot : m_trustedSchemas[contentPrefix]);
+      if(CustomSchemaTlv::isTlv(buf, size)) {
+        CUSTOM_PROFILE_SCOPE("CustomSchemaTlv::decode");
+        rules = CustomSchemaTlv::decode(::ndn::Block(buf, size));
+      } else {
+        std::string contentStr(buf, buf + size);
+        std::stringstream inputStream(contentStr);
+        NS_LOG_INFO("InputStream: \n" << inputStream.str());
+        CUSTOM_PROFILE_SCOPE("read_info(schema)");
+        boost::property_tree::read_info(inputStream, rules);
+      }
+      reloadValidationRules();
+    }
+
+    /// @brief /<zone>/SCHEMA/CONTENT/v=<n>/seg=<k> of a known zone
+    bool CustomApp::isSchemaSegment(const ::ndn::Name &name) {
+      if(name.size() < 2) {
+        return false;
+      }
+      auto it = m_schemaFetches.find(name.getPrefix(-2));
+      return (it != m_schemaFetches.end());
+    }
+
+    void CustomApp::sendSchemaSegmentInterest(const ::ndn::Name &contentPrefix, size_t segment) {
+      auto &fetch = m_schemaFetches[contentPrefix];
+      auto name = contentPrefix.deepCopy();
+      name.appendVersion(fetch.manifest.version).appendSegment(segment);
+      // full name: only the segment listed in the manifest matches (several anchors may serve the zone)
+      name.append(fetch.manifest.digests[segment]);
+      // segments are immutable, so cached copies are fine
+      InterestOptions opts;
+      opts.canBePrefix = false;
+      opts.mustBeFresh = false;
+      sendInterest(name, m_schemaSubscribeLifetime, opts);
+      // lost or Nacked: sent again once the Interest expired (still within the fetch window)
+      m_sendEvents[name.getPrefix(-1).toUri()] =
+          Simulator::Schedule(m_schemaSubscribeLifetime, &CustomApp::retransmitSchemaSegment, this,
+                              contentPrefix, fetch.manifest.version, segment);
+    }
+
+    void CustomApp::retransmitSchemaSegment(const ::ndn::Name &contentPrefix, uint64_t version,
+                                            size_t segment) {
+      auto &fetch = m_schemaFetches[contentPrefix];
+      if(fetch.manifest.version != version || fetch.segments[segment] != nullptr) {
+        // stale timer (fetch restarted with a newer version, or finished)
+        auto name = contentPrefix.deepCopy().appendVersion(version).appendSegment(segment).toUri();
+        m_sendEvents.erase(name);
+        return;
+      }
+      NS_LOG_DEBUG("Retransmitting SCHEMA segment " << segment << " of '" << contentPrefix << "'");
+      sendSchemaSegmentInterest(contentPrefix, segment);
+    }
+
+    void CustomApp::OnDataSchemaSegment(std::shared_ptr<const ndn::Data> data) {
+      NS_LOG_FUNCTION(data->getName());
+      auto contentPrefix = data->getName().getPrefix(-2);
+      auto &fetch = m_schemaFetches[contentPrefix];
+      auto &versionComponent = data->getName().get(-2);
+      auto &segmentComponent = data->getName().get(-1);
+      if(fetch.manifest.version == 0 || !versionComponent.isVersion() ||
+         versionComponent.toVersion() != fetch.manifest.version || !segmentComponent.isSegment() ||
+         segmentComponent.toSegment() >= fetch.segments.size()) {
+        NS_LOG_DEBUG("Dropping unexpected SCHEMA segment '" << data->getName() << "'");
+        return;
+      }
+      auto segment = segmentComponent.toSegment();
+      if(fetch.segments[segment] != nullptr) {
+        return; // duplicate
+      }
+      // the manifest signature covers the implicit digest of every segment
+      if(data->getFullName().get(-1) != fetch.manifest.digests[segment]) {
+        NS_LOG_WARN("SCHEMA segment '" << data->getName() << "' does not match the manifest digest");
+        return;
+      }
+      fetch.segments[segment] = data;
+      fetch.received++;
+      auto segmentEvent = m_sendEvents.find(data->getName().toUri());
+      if(segmentEvent != m_sendEvents.end()) {
+        Simulator::Cancel(segmentEvent->second);
+        m_sendEvents.erase(segmentEvent);
+      }
+      if(fetch.next < fetch.segments.size()) {
+        sendSchemaSegmentInterest(contentPrefix, fetch.next++);
+      }
+      if(fetch.received < fetch.segments.size()) {
+        return;
+      }
+
+      // all segments received, reassemble payload
+      ::ndn::Buffer payload;
+      for(const auto &segmentData : fetch.segments) {
+        auto &content = segmentData->getContent();
+        payload.insert(payload.end(), content.value_begin(), content.value_end());
+      }
+      auto version = fetch.manifest.version;
+      fetch.manifest = CustomSchemaTlv::Manifest();
+      fetch.segments.clear();
+      try {
+        NS_LOG_INFO("Reading trust schema '" << contentPrefix << "' version=" << version << " ("
+                                             << payload.size() << " bytes) ... ");
+        loadValidationRules(contentPrefix, payload.data(), payload.size());
+        fetch.version = version;
+        logEvent(CustomEventLog::SCHEMA_UPDATE, version);
+      } catch(const std::exception &e) {
+        throw std::runtime_error("Failed load validation rules version=" + std::to_string(version) +
+                                 " - Error=" + e.what());
+      }
+    }
+
+    /// @brief certificates bundled with the Data are cached as unverified, the validator checks them (as
+    ///        part of the chain) without fetching them from the network
+    void CustomApp::cacheAttachedCertificates(const ndn::Data &data) {
+      auto bundle = data.getMetaInfo().findAppMetaInfo(CustomSchemaTlv::CertificateBundle);
+      if(bundle == nullptr) {
+        return;
+      }
+      try {
+        bundle->parse();
+        for(const auto &element : bundle->elements()) {
+          ::ndn::security::v2::Certificate cert(element);
+          NS_LOG_DEBUG("Caching attached certificate '" << cert.getName() << "'");
+          m_validator->cacheUnverifiedCertificate(std::move(cert));
+        }
+      } catch(const std::exception &e) {
+        NS_LOG_WARN("Ignoring certificates attached to '" << data.getName() << "' - Error=" << e.what());
+      }
+    }
+
+    void CustomApp::validateData(std::shared_ptr<const ndn::Data> data) {
+      auto sigType = data->getSignature().getType();
+      if(m_batchPending.count(data->getName()) > 0 && sigType != ::ndn::tlv::SignatureSha256WithRsa &&
+         sigType != ::ndn::tlv::SignatureSha256WithEcdsa) {
+        // a BATCH root carries the producer signature (a Merkle signed root would only point to another one)
+        OnDataValidationFailed(data, ::ndn::security::v2::ValidationError(
+                                         ::ndn::security::v2::ValidationError::INVALID_SIGNATURE,
+                                         "BATCH root is not signed with RSA or ECDSA"));
+        return;
+      }
+      if(sigType == CustomMerkleTree::SignatureMerkleSha256) {
+        validateBatchedData(data);
+        return;
+      }
+      NS_LOG_DEBUG("Validating Data ... ");
+      cacheAttachedCertificates(*data);
+      if(m_validationPolicy->isAllowed(*data)) {
+        // signer certificate already trusted (trust anchor, or verified before): the signature is the only
+        // check left, done on the crypto pool (whatever the number of worker threads)
+        ::ndn::Interest certInterest(data->getSignature().getKeyLocator().getName());
+        certInterest.setCanBePrefix(true);
+        auto cert = m_validator->findTrustedCert(certInterest);
+        if(cert != nullptr) {
+          verifyAsync(data, *cert);
+          return;
+        }
+      }
+      // (synchronous part: signature verification when the certificate chain is already known)
+      CUSTOM_PROFILE_SCOPE("Validator::validate");
+      auto start = std::chrono::steady_clock::now();
+      // callbacks keep the received packet (many validations may wait for certificates at once)
+      m_validator->validate(
+          *data, [this, data](const ndn::Data &) { OnDataValidated(data); },
+          [this, data](const ndn::Data &, const ::ndn::security::v2::ValidationError &error) {
+            OnDataValidationFailed(data, error);
+          });
+      traceCryptoTime(start);
+    }
+
+    /// @brief batch-signed Data: check its inclusion proof against the (validated) Merkle root named by its
+    ///        KeyLocator, fetching the root first if needed
+    void CustomApp::validateBatchedData(std::shared_ptr<const ndn::Data> data) {
+      auto rootName = data->getSignature().getKeyLocator().getName();
+      // /<prefix>/BATCH/<node>/<seq>, where <prefix> (checked by the rule of the root) covers the Data name
+      if(rootName.size() < 3 || rootName.get(-3) != ::ndn::name::Component("BATCH") ||
+         !rootName.getPrefix(-3).isPrefixOf(data->getName())) {
+        OnDataValidationFailed(data, ::ndn::security::v2::ValidationError(
+                                         ::ndn::security::v2::ValidationError::INVALID_KEY_LOCATOR,
+                                         "`" + rootName.toUri() + "` is not a BATCH root of the Data"));
+        return;
+      }
+      auto root = m_batchRoots.find(rootName);
+      if(root != m_batchRoots.end()) {
+        verifyBatchedData(data, *root->second);
+        return;
+      }
+      auto &fetch = m_batchPending[rootName];
+      fetch.pending.push_back(data);
+      if(fetch.pending.size() == 1) {
+        NS_LOG_DEBUG("Fetching BATCH root '" << rootName << "' of '" << data->getName() << "'");
+        sendBatchRootInterest(rootName);
+      }
+    }
+
+    /// @brief request a BATCH root, retransmitted after its lifetime (see retransmitBatchRoot)
+    void CustomApp::sendBatchRootInterest(const ::ndn::Name &rootName) {
+      sendInterest(rootName, m_batchRootLifetime);
+      m_sendEvents[rootName.toUri()] =
+          Simulator::Schedule(m_batchRootLifetime, &CustomApp::retransmitBatchRoot, this, rootName);
+    }
+
+    /// @brief BATCH root Interest timed out or Nacked: retransmit it, or fail its batch after
+    ///        MAX_BATCH_ROOT_RETRIES retransmissions
+    void CustomApp::retransmitBatchRoot(const ::ndn::Name &rootName) {
+      m_sendEvents.erase(rootName.toUri());
+      auto fetch = m_batchPending.find(rootName);
+      if(fetch == m_batchPending.end()) {
+        return;
+      }
+      if(fetch->second.retries >= MAX_BATCH_ROOT_RETRIES) {
+        NS_LOG_INFO("Dropping BATCH '" << rootName << "' - root not received");
+        ::ndn::security::v2::ValidationError error(::ndn::security::v2::ValidationError::CANNOT_RETRIEVE_CERT,
+                                                   "Cannot retrieve BATCH root `" + rootName.toUri() + "`");
+        for(const auto &batchedData : takeBatchPending(rootName)) {
+          OnDataValidationFailed(batchedData, error);
+        }
+        return;
+      }
+      fetch->second.retries++;
+      NS_LOG_DEBUG("Retransmitting BATCH root '" << rootName << "'");
+      sendBatchRootInterest(rootName);
+    }
+
+    /// @brief remove the Data waiting for a BATCH root (and its retransmission timer)
+    std::vector<std::shared_ptr<const ndn::Data>> CustomApp::takeBatchPending(const ::ndn::Name &rootName) {
+      auto fetch = m_batchPending.find(rootName);
+      if(fetch == m_batchPending.end()) {
+        return {};
+      }
+      auto batch = std::move(fetch->second.pending);
+      m_batchPending.erase(fetch);
+      auto rootNameStr = rootName.toUri();
+      if(hasEvent(rootNameStr)) {
+        Simulator::Cancel(m_sendEvents[rootNameStr]);
+        m_sendEvents.erase(rootNameStr);
+      }
+      return batch;
+    }
+
+    void CustomApp::verifyBatchedData(std::shared_ptr<const ndn::Data> data, const ::ndn::Buffer &root) {
+      CUSTOM_PROFILE_SCOPE("CustomMerkleTree::verifyData");
+      auto start = std::chrono::steady_clock::now();
+      bool isValid = CustomMerkleTree::verifyData(*data, root);
+      traceCryptoTime(start);
+      if(isValid) {
+        OnDataValidated(data);
+      } else {
+        OnDataValidationFailed(data, ::ndn::security::v2::ValidationError(
+                                         ::ndn::security::v2::ValidationError::INVALID_SIGNATURE,
+                                         "Merkle inclusion proof does not match the BATCH root"));
+      }
+    }
+
     /// @brief reload validation rules stored in memory
-    void CustomApp::reloadValidationRules() {
+    /// @param ruleIndex rules of m_validatorRoot already compiled (nullptr to compile them)
+    void CustomApp::reloadValidationRules(std::shared_ptr<const CustomRuleIndex> ruleIndex) {
       // print Validation Rules
       printValidationRules();
-      // load validatorRoot into validatorConf
+      // own zone rules first, then the rules (and trust anchors) of every trusted zone
+      const ::ndn::security::v2::validator_config::ConfigSection *schema = m_validatorRoot.get();
+      ::ndn::security::v2::validator_config::ConfigSection merged;
+      if(!m_trustedSchemas.empty()) {
+        merged = *m_validatorRoot;
+        for(const auto &pairPrefixRules : m_trustedSchemas) {
+          for(const auto &item : pairPrefixRules.second) {
+            merged.push_back(item);
+          }
+        }
+        schema = &merged;
+        ruleIndex = nullptr; // precompiled index only covers m_validatorRoot
+      }
+      // load trust anchors of validatorRoot
       m_validator->resetAnchors();
       m_validator->resetVerifiedCertificates();
-      m_validator->load(*m_validatorRoot, m_validatorConf);
-      NS_LOG_INFO("Trust schema RELOADED");
+      bool bypass = false;
+      for(const auto &item : *schema) {
+        if(item.first != "trust-anchor") {
+          continue;
+        }
+        auto anchorType = item.second.get<std::string>("type", "file");
+        if(anchorType == "any") {
+          bypass = true;
+        } else if(anchorType == "file") {
+          auto filename = item.second.get<std::string>("file-name");
+          auto cert = CustomSchemaStore::getInstance().readCertificate(filename);
+          m_validator->loadAnchor(filename, ::ndn::security::v2::Certificate(*cert));
+        } else {
+          throw std::runtime_error("Unsupported trust-anchor type '" + anchorType + "'");
+        }
+      }
+      // index validatorRoot rules by name prefix
+      if(ruleIndex == nullptr) {
+        auto newIndex = std::make_shared<CustomRuleIndex>();
+        newIndex->load(*schema);
+        ruleIndex = newIndex;
+      }
+      m_validationPolicy->setRuleIndex(ruleIndex);
+      m_validationPolicy->setBypass(bypass);
+      NS_LOG_INFO("Trust schema RELOADED (" << ruleIndex->size() << " rules)");
     }
 
   } // namespace ndn
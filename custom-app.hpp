@@ -5,9 +5,11 @@
 
 // NDN-CXX
 #include "ns3/ndnSIM/ndn-cxx/lp/fields.hpp"
+#include "ns3/ndnSIM/ndn-cxx/lp/nack.hpp"
 #include "ns3/ndnSIM/ndn-cxx/lp/tags.hpp"
 #include "ns3/ndnSIM/ndn-cxx/security/key-chain.hpp"
 #include "ns3/ndnSIM/ndn-cxx/security/signing-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validator.hpp"
 #include "ns3/ndnSIM/ndn-cxx/security/validator-config.hpp"
 
 // NS3 / NDNSIM
@@ -19,10 +21,13 @@
 #include "ns3/simulator.h"
 
 // system libs
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -34,6 +39,17 @@
 #include <boost/property_tree/ptree.hpp>
 
 // custom includes
+#include "custom-cpu-model.hpp"
+#include "custom-crypto-energy-model.hpp"
+#include "custom-crypto-pool.hpp"
+#include "custom-event-log.hpp"
+#include "custom-group-key.hpp"
+#include "custom-merkle-tree.hpp"
+#include "custom-rule-index.hpp"
+#include "custom-schema-rules.hpp"
+#include "custom-schema-store.hpp"
+#include "custom-schema-tlv.hpp"
+#include "custom-snapshot.hpp"
 #include "custom-utils.hpp"
 
 // namespace ns3 {
@@ -71,6 +87,24 @@ namespace ns3 {
         DataOptions() {}
       };
 
+      /// @brief per-packet validation state, carried with the Data through the validation callbacks
+      struct ValidationContext {
+        bool validated; ///< @brief Data passed the validator (false = validation skipped)
+
+        ValidationContext(bool isValidated = false) : validated(isValidated) {}
+      };
+
+    public:
+      /// @brief sign/verify operation done (app, wall-clock time spent in the operation)
+      typedef void (*CryptoTimeCallback)(Ptr<App> app, Time wallTime);
+
+    public:
+      static const size_t MAX_BATCH_ROOTS; ///< @brief Merkle BATCH roots kept (signed or validated)
+      /// @brief retransmissions of a BATCH root Interest (timeout or Nack) before its batch fails
+      static const uint32_t MAX_BATCH_ROOT_RETRIES;
+      /// @brief manifests requested again in a row while they are older than the announced SCHEMA generation
+      static const uint32_t MAX_STALE_SCHEMA_REQUESTS;
+
     public:
       static bool isValidKeyName(const ::ndn::Name &keyName);
       static bool isValidCertificateName(const ::ndn::Name &certName);
@@ -86,43 +120,74 @@ namespace ns3 {
       // when interest/data are received
       void OnInterest(std::shared_ptr<const ndn::Interest> interest) override;
       void OnData(std::shared_ptr<const ndn::Data> data) override;
+      void OnNack(std::shared_ptr<const ::ndn::lp::Nack> nack) override;
 
       virtual void OnInterestKey(std::shared_ptr<const ndn::Interest> interest);
       virtual void OnInterestContent(std::shared_ptr<const ndn::Interest> interest);
 
-      virtual void OnDataCertificate(std::shared_ptr<const ndn::Data> data);
-      virtual void OnDataContent(std::shared_ptr<const ndn::Data> data);
+      virtual void OnDataCertificate(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx);
+      virtual void OnDataContent(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx);
 
       // data validation callbacks
-      virtual void OnDataValidated(const ndn::Data &data);
-      virtual void OnDataValidationFailed(const ndn::Data &data,
+      virtual void OnDataValidated(std::shared_ptr<const ndn::Data> data);
+      virtual void OnDataValidationFailed(std::shared_ptr<const ndn::Data> data,
                                           const ::ndn::security::v2::ValidationError &error);
 
+      /// @brief add the post-bootstrap state of the app to a snapshot (warm start of later runs)
+      virtual void writeSnapshot(CustomSnapshot &snapshot);
+
     protected:
       void setSignValidityPeriod(int daysValid);
+      ::ndn::time::milliseconds getValidityFreshness();
       void setShouldValidateData(bool validate);
       bool getShouldValidateData();
 
       void readValidationRules();
       void readValidationRules(std::shared_ptr<const ndn::Data> data);
+      void readTrustedZones();
+      void fetchValidationRules(std::shared_ptr<const ndn::Data> manifestData);
+      void requestValidationRules();
+      void requestSchemaManifest(const ::ndn::Name &contentPrefix);
+      bool restoreValidationRules();
+      bool OnDataSchema(std::shared_ptr<const ndn::Data> data);
 
       void writeValidationRules();
 
       void clearValidationRules();
       std::string getValidationRules();
+      ::ndn::Block getValidationRulesBlock();
 
       void addValidationRule(std::string dataRegex, std::string keyLocatorRegex);
+      void addValidationRule(const ::ndn::security::v2::validator_config::ConfigSection &rule);
+      void insertValidationRule(size_t position,
+                                const ::ndn::security::v2::validator_config::ConfigSection &rule);
+      void setValidationSection(const std::string &key,
+                                const ::ndn::security::v2::validator_config::ConfigSection &section);
       void addTrustAnchor(std::string filename);
 
-      std::string getValidationRegex(const ::ndn::Name &prefix);
-
       void sendInterest(::ndn::Name name, ns3::Time lifeTime,
                         const InterestOptions &opts = InterestOptions());
       void sendInterest(std::string name, ns3::Time lifeTime,
                         const InterestOptions &opts = InterestOptions());
       void sendInterest(std::shared_ptr<ndn::Interest> interest);
 
+      void sign(ndn::Data &data, const ::ndn::security::SigningInfo &signingInfo);
+      void sign(ndn::Interest &interest, const ::ndn::security::SigningInfo &signingInfo);
+      void signAsync(std::shared_ptr<ndn::Data> data, const ::ndn::security::SigningInfo &signingInfo,
+                     std::function<void()> onSigned);
+      void signAsync(std::vector<std::shared_ptr<ndn::Data>> datas,
+                     const ::ndn::security::SigningInfo &signingInfo, std::function<void()> onSigned,
+                     std::function<void(size_t)> beforeSign = nullptr);
+      void traceCryptoTime(std::chrono::steady_clock::time_point start);
+      void chargeCpu(CustomCpuModel::Operation op, uint32_t sigType);
+      void chargeEnergy(CustomCryptoEnergyModel::Operation op, uint32_t sigType);
+      void logEvent(CustomEventLog::Type type, uint64_t value = 0);
+      static uint32_t getSignatureType(const ndn::Interest &interest);
+      uint32_t getSignatureType(const ::ndn::security::SigningInfo &signingInfo);
+
       void sendData(std::shared_ptr<ndn::Data> data);
+      void attachCertificate(ndn::Data &data, const ::ndn::security::v2::Certificate &cert);
+      void sendNack(std::shared_ptr<const ndn::Interest> interest, ::ndn::lp::NackReason reason);
 
       void sendCertificate(std::shared_ptr<const ndn::Interest> interest,
                            const DataOptions &opts = DataOptions());
@@ -130,13 +195,13 @@ namespace ns3 {
       void sendCertificate(std::shared_ptr<::ndn::security::v2::Certificate> cert);
 
       void addCertificate(::ndn::security::v2::Certificate &cert);
-      const ::ndn::security::v2::Certificate &createCertificate(const ndn::Name &prefix);
+      const ::ndn::security::v2::Certificate &
+      createCertificate(const ndn::Name &prefix,
+                        const ::ndn::KeyParams &params = ::ndn::KeyChain::getDefaultKeyParams());
 
       void printKeyChain();
       void printValidationRules();
 
-      bool isDataValid();
-
       void eraseSendEvent(std::string &name);
       bool hasEvent(std::string &name);
       bool isEventRunning(std::string &name);
@@ -145,7 +210,56 @@ namespace ns3 {
       void sendSubscribeSchema();
 
     private:
-      void reloadValidationRules();
+      /// @brief SCHEMA of one zone (own zone or trusted zone), fetched as a segmented object
+      struct SchemaFetch {
+        uint64_t version = 0;               ///< @brief version of the loaded SCHEMA (0 = from file)
+        CustomSchemaTlv::Manifest manifest; ///< @brief version 0 = no fetch running
+        std::vector<std::shared_ptr<const ndn::Data>> segments; ///< @brief nullptr = missing
+        size_t next = 0;                                        ///< @brief next segment to request
+        size_t received = 0;                                    ///< @brief number of segments received
+        uint64_t announced = 0; ///< @brief latest version announced by SCHEMA/SUBSCRIBE
+        uint32_t staleRequests = 0; ///< @brief manifests requested again in a row (MAX_STALE_SCHEMA_REQUESTS)
+      };
+
+      /// @brief batch-signed Data waiting for their Merkle root to be fetched and validated
+      struct BatchFetch {
+        std::vector<std::shared_ptr<const ndn::Data>> pending;
+        uint32_t retries = 0; ///< @brief root Interests retransmitted
+      };
+
+      /// @brief CustomCryptoPool job: on the worker threads once submitted, or run by finishCryptoJob (none)
+      struct CryptoJob {
+        std::function<void()> work;
+        std::shared_future<void> future; ///< @brief invalid until submitted
+        std::shared_ptr<std::chrono::nanoseconds> wallTime;
+      };
+
+    private:
+      void reloadValidationRules(std::shared_ptr<const CustomRuleIndex> ruleIndex = nullptr);
+      void loadValidationRules(const ::ndn::Name &contentPrefix, const uint8_t *buf, size_t size);
+
+      bool isSchemaSegment(const ::ndn::Name &name);
+      void sendSchemaSegmentInterest(const ::ndn::Name &contentPrefix, size_t segment);
+      void retransmitSchemaSegment(const ::ndn::Name &contentPrefix, uint64_t version, size_t segment);
+      void OnDataSchemaSegment(std::shared_ptr<const ndn::Data> data);
+
+      void cacheAttachedCertificates(const ndn::Data &data);
+      void validateData(std::shared_ptr<const ndn::Data> data);
+      void validateBatchedData(std::shared_ptr<const ndn::Data> data);
+      void verifyBatchedData(std::shared_ptr<const ndn::Data> data, const ::ndn::Buffer &root);
+      void sendBatchRootInterest(const ::ndn::Name &rootName);
+      void retransmitBatchRoot(const ::ndn::Name &rootName);
+      std::vector<std::shared_ptr<const ndn::Data>> takeBatchPending(const ::ndn::Name &rootName);
+      void verifyAsync(std::shared_ptr<const ndn::Data> data, const ::ndn::security::v2::Certificate &cert);
+      std::shared_ptr<CryptoJob> submitCryptoJob(std::function<void()> work);
+      void finishCryptoJob(std::shared_ptr<CryptoJob> job, std::function<void()> onDone, uint64_t events,
+                           uint64_t jobEvents);
+      ::ndn::security::pib::Key getSigningKey(const ::ndn::security::SigningInfo &signingInfo);
+      std::shared_ptr<const ::ndn::security::transform::PrivateKey>
+      getPrivateKey(const ::ndn::security::SigningInfo &signingInfo, ::ndn::SignatureInfo &sigInfo);
+
+      void transmitInterest(std::shared_ptr<ndn::Interest> interest);
+      void transmitData(std::shared_ptr<ndn::Data> data);
 
     protected:
       std::shared_ptr<::ndn::Face> m_face_NDN_CXX; ///< @brief ndn::Face to allow real-world
@@ -162,17 +276,48 @@ namespace ns3 {
       ::ndn::Name m_signPrefix; ///< @brief common SIGN prefix (to request trust anchor signing)
       ns3::Time m_signLifetime; ///< @brief lifetime of SIGN interests
 
+      ::ndn::Name m_groupKeyPrefix;     ///< @brief zone group key prefix (encrypted key for each producer)
+      bool m_useGroupKey;               ///< @brief content Data signed with the zone group HMAC key
+      ::ndn::Name m_groupKeyName;       ///< @brief /<zone>/GROUPKEY/<version> (KeyLocator of HMAC Data)
+      ::ndn::ConstBufferPtr m_groupKey; ///< @brief nullptr until created (trust anchor) or fetched (producer)
+
       ::ndn::security::v2::KeyChain m_keyChain;
       ::ndn::security::SigningInfo m_signingInfo;
+      /// @brief held while using m_keyChain (CustomCryptoPool jobs sign with m_privateKeys instead)
+      std::recursive_mutex m_keyChainMutex;
 
       std::map<std::string, ::ns3::EventId> m_sendEvents; ///< @brief pending "send packet" event
 
     private:
-      std::shared_ptr<::ndn::ValidatorConfig> m_validator; ///< @brief validates data packets
+      std::shared_ptr<::ndn::security::v2::Validator> m_validator; ///< @brief validates data packets
+      CustomValidationPolicy *m_validationPolicy; ///< @brief trust schema policy (owned by m_validator)
       std::shared_ptr<::ndn::security::v2::validator_config::ConfigSection> m_validatorRoot;
 
+      uint32_t m_schemaFetchWindow;                     ///< @brief max SCHEMA segments in flight (per zone)
+      std::map<::ndn::Name, SchemaFetch> m_schemaFetches; ///< @brief by SCHEMA/CONTENT prefix
+
+      std::string m_trustedZones; ///< @brief "<zone>=<validatorConf> ..." of other zones to accept Data from
+      /// @brief SCHEMA rules of the trusted zones (merged with m_validatorRoot), by SCHEMA/CONTENT prefix
+      std::map<::ndn::Name, ::ndn::security::v2::validator_config::ConfigSection> m_trustedSchemas;
+
+      TracedCallback<Ptr<App>, Time> m_cryptoTime;
+
+      Ptr<CustomCpuModel> m_cpuModel; ///< @brief CPU of the node (nullptr = sign/verify cost no time)
+      Time m_cpuReady;                ///< @brief packets sent wait for the CPU operations queued until then
+      /// @brief crypto energy model of the node (nullptr = sign/verify/keygen cost no energy)
+      Ptr<CustomCryptoEnergyModel> m_energyModel;
+
+      std::vector<std::shared_future<void>> m_cryptoJobs; ///< @brief signAsync/verifyAsync jobs not finished
+      /// @brief private keys of m_keyChain exported for the CustomCryptoPool jobs, by key name
+      std::map<::ndn::Name, std::shared_ptr<const ::ndn::security::transform::PrivateKey>> m_privateKeys;
+
+      ns3::Time m_batchRootLifetime; ///< @brief lifetime of Interests for Merkle BATCH roots
+      /// @brief validated Merkle roots (by root Data name), oldest first in m_batchRootOrder
+      std::map<::ndn::Name, ::ndn::ConstBufferPtr> m_batchRoots;
+      std::deque<::ndn::Name> m_batchRootOrder;
+      std::map<::ndn::Name, BatchFetch> m_batchPending; ///< @brief by BATCH root name
+
       bool m_shouldValidateData;
-      bool m_dataIsValid;
     };
 
   } // namespace ndn
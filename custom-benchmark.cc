@@ -0,0 +1,395 @@
+// custom-benchmark.cpp
+
+#include "custom-benchmark.hpp"
+#include "custom-crypto-pool.hpp"
+#include "custom-cs-policy.hpp"
+#include "custom-group-key.hpp"
+#include "custom-merkle-tree.hpp"
+#include "custom-rule-index.hpp"
+#include "custom-utils.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/security/key-chain.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/signing-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/verification-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/regex.hpp"
+
+// NDNSIM NFD
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-lru.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-priority-fifo.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+
+// system libs
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace ns3 {
+  namespace ndn {
+
+    namespace {
+
+      using ConfigSection = ::ndn::security::v2::validator_config::ConfigSection;
+
+      // same rule layout as CustomApp::addValidationRule()
+      void pushRule(ConfigSection &schema, const std::string &dataRegex, const std::string &keyLocatorRegex) {
+        ConfigSection rule;
+        rule.put("id", dataRegex);
+        rule.put("for", "data");
+        rule.put("filter.type", "name");
+        rule.put("filter.regex", dataRegex);
+        rule.put("checker.type", "customized");
+        rule.put("checker.sig-type", "rsa-sha256");
+        rule.put("checker.key-locator.type", "name");
+        rule.put("checker.key-locator.regex", keyLocatorRegex);
+        schema.push_front(std::make_pair("rule", rule));
+      }
+
+      // same rules as CustomTrustAnchor::createTrustAnchor() / addProducerSchema()
+      ConfigSection createZoneSchema(size_t nProducers) {
+        ConfigSection schema;
+        pushRule(schema, "^<zoneA><SIGN><>*$", "^<zoneA><KEY><>{1,3}$");
+        pushRule(schema, "^<zoneA><SCHEMA><>*$", "^<zoneA><KEY><>{1,3}$");
+        for(size_t i = 0; i < nProducers; i++) {
+          auto identity = "<zoneA><producer" + std::to_string(i) + ">";
+          pushRule(schema, "^" + identity + "<KEY><>{1,3}$", "^<zoneA><KEY><>{1,3}$");
+          pushRule(schema, "^" + identity + "[^<KEY>]*$", "^" + identity + "<KEY><>{1,3}$");
+        }
+        return schema;
+      }
+
+      template <typename F> double measureOpsPerSecond(size_t ops, F &&op) {
+        auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < ops; i++) {
+          op(i);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return ops / elapsed.count();
+      }
+
+      // content Data of producer0 (1KB payload), not signed yet
+      std::vector<std::shared_ptr<::ndn::Data>> makeContents(size_t packets) {
+        std::vector<std::shared_ptr<::ndn::Data>> contents;
+        for(size_t i = 0; i < packets; i++) {
+          auto data = std::make_shared<::ndn::Data>("/zoneA/producer0/test/prefix/" + std::to_string(i));
+          data->setFreshnessPeriod(::ndn::time::seconds(2));
+          data->setContent(std::make_shared<::ndn::Buffer>(1024));
+          contents.push_back(data);
+        }
+        return contents;
+      }
+
+      // one KeyChain signature per Data (the baseline row of merkle-batch and group-key): {sign/s, verify/s}
+      std::pair<double, double> measureSignVerify(::ndn::KeyChain &keyChain,
+                                                  const ::ndn::security::pib::Identity &identity,
+                                                  const std::vector<std::shared_ptr<::ndn::Data>> &contents,
+                                                  size_t &failed) {
+        auto cert = identity.getDefaultKey().getDefaultCertificate();
+        auto signingInfo = ::ndn::security::signingByIdentity(identity);
+        double sign = measureOpsPerSecond(contents.size(), [&](size_t i) {
+          keyChain.sign(*contents[i], signingInfo);
+        });
+        double verify = measureOpsPerSecond(contents.size(), [&](size_t i) {
+          failed += !::ndn::security::verifySignature(*contents[i], cert);
+        });
+        return {sign, verify};
+      }
+
+      // "<label>\t<sign/s>\t<verify/s>\t<speedups>" (relative to the first row), the caller ends the line
+      void writeSignVerifyRow(std::ostream &os, const std::string &label, std::pair<double, double> rates,
+                              size_t failed, std::pair<double, double> &baseline) {
+        if(failed > 0) {
+          os << "WARNING - " << failed << " signatures failed to verify\n";
+        }
+        if(baseline.first == 0.0) {
+          baseline = rates;
+        }
+        os << label << "\t" << rates.first << "\t" << rates.second << "\t" << rates.first / baseline.first
+           << "\t" << rates.second / baseline.second;
+      }
+
+      std::unique_ptr<::nfd::cs::Policy> createCsPolicy(const std::string &policyName) {
+        if(policyName == "lru") {
+          return std::make_unique<::nfd::cs::LruPolicy>();
+        } else if(policyName == "priority_fifo") {
+          return std::make_unique<::nfd::cs::PriorityFifoPolicy>();
+        }
+        return std::make_unique<CustomCsPolicy>();
+      }
+
+    } // namespace
+
+    bool CustomBenchmark::run(const std::string &name, std::ostream &os) {
+      if(name == "rule-index") {
+        ruleIndex(os, {10, 100, 500, 1000}, 2000);
+        return true;
+      } else if(name == "cs-policy") {
+        csPolicy(os, {10, 50, 100, 500}, 20000);
+        return true;
+      } else if(name == "merkle-batch") {
+        merkleBatch(os, {1, 4, 16, 64, 256}, 1024);
+        return true;
+      } else if(name == "group-key") {
+        groupKey(os, 1024);
+        return true;
+      } else if(name == "crypto-pool") {
+        cryptoPool(os, {0, 1, 2, 4, 8}, 1024);
+        return true;
+      }
+      return false;
+    }
+
+    void CustomBenchmark::ruleIndex(std::ostream &os, const std::vector<size_t> &producerCounts,
+                                    size_t lookups) {
+      os << "Producers\tRules\tLinearLookups/s\tIndexedLookups/s\tSpeedup\n";
+      std::mt19937 gen(1);
+      for(auto nProducers : producerCounts) {
+        auto schema = createZoneSchema(nProducers);
+
+        // linear scan in schema order (ValidatorConfig behavior)
+        std::vector<std::shared_ptr<::ndn::Regex>> linearRules;
+        for(const auto &item : schema) {
+          linearRules.push_back(std::make_shared<::ndn::Regex>(item.second.get<std::string>("filter.regex")));
+        }
+        CustomRuleIndex index;
+        index.load(schema);
+
+        // content and certificate names of random producers
+        std::uniform_int_distribution<size_t> distrib(0, nProducers - 1);
+        std::vector<::ndn::Name> names;
+        for(size_t i = 0; i < lookups; i++) {
+          ::ndn::Name name("/zoneA/producer" + std::to_string(distrib(gen)));
+          names.push_back(i % 2 ? name.append("KEY").append("keyId").append("issuer").append("v1")
+                                : name.append("content").appendNumber(i));
+        }
+
+        size_t matched = 0;
+        double linear = measureOpsPerSecond(lookups, [&](size_t i) {
+          for(auto &regex : linearRules) {
+            if(regex->match(names[i])) {
+              matched++;
+              break;
+            }
+          }
+        });
+        double indexed = measureOpsPerSecond(lookups, [&](size_t i) {
+          if(index.findRule(names[i]) != nullptr) {
+            matched++;
+          }
+        });
+        if(matched != 2 * lookups) {
+          os << "WARNING - linear and indexed lookups disagree (" << matched << "/" << 2 * lookups << ")\n";
+        }
+        os << nProducers << "\t" << index.size() << "\t" << linear << "\t" << indexed << "\t"
+           << indexed / linear << "\n";
+      }
+    }
+
+    void CustomBenchmark::csPolicy(std::ostream &os, const std::vector<size_t> &csSizes, size_t requests) {
+      // content of 20 producers (1000 names, Zipf 0.8) on a forwarder shared by consumers. After a content
+      // Data, 10% of the consumers still have to fetch the producer certificate to validate it.
+      const size_t nProducers = 20, catalogSize = 1000;
+      const double certProbability = 0.1;
+      const double upstreamRtt = 20.0; // ms, forwarder <=> producer (2 hops of 5ms)
+
+      ::ndn::KeyChain keyChain("pib-memory:", "tpm-memory:");
+      auto makeData = [&keyChain](const ::ndn::Name &name) {
+        auto data = std::make_shared<::ndn::Data>(name);
+        data->setFreshnessPeriod(::ndn::time::seconds(2));
+        keyChain.sign(*data, ::ndn::security::signingWithSha256());
+        return data;
+      };
+      std::vector<std::shared_ptr<::ndn::Data>> contents, certs;
+      for(size_t rank = 1; rank <= catalogSize; rank++) {
+        contents.push_back(makeData("/zoneA/producer" + std::to_string(rank % nProducers) + "/test/prefix/" +
+                                    std::to_string(rank)));
+      }
+      for(size_t i = 0; i < nProducers; i++) {
+        certs.push_back(makeData("/zoneA/producer" + std::to_string(i) + "/KEY/keyId/zoneA/v=1"));
+      }
+      utils::ZipfMandelbrot catalog(catalogSize, 0.8);
+
+      const std::vector<std::string> policyNames = {"lru", "priority_fifo", CustomCsPolicy::POLICY_NAME};
+      os << "CsSize\tPolicy\tContentHitRatio\tCertFetches\tCertFetchesAvoided\tValidationLatencySaved(ms)\n";
+      for(auto csSize : csSizes) {
+        size_t lruCertFetches = 0;
+        for(const auto &policyName : policyNames) {
+          ::nfd::cs::Cs cs(csSize);
+          cs.setPolicy(createCsPolicy(policyName));
+
+          // same request sequence for every policy
+          std::mt19937 gen(1);
+          std::uniform_real_distribution<double> uniform(0.0, 1.0);
+          size_t contentHits = 0, certFetches = 0;
+          auto request = [&cs](const std::shared_ptr<::ndn::Data> &data) {
+            bool hit = false;
+            ::ndn::Interest interest(data->getName());
+            interest.setCanBePrefix(false);
+            cs.find(interest, [&hit](const ::ndn::Interest &, const ::ndn::Data &) { hit = true; },
+                    [](const ::ndn::Interest &) {});
+            if(!hit) {
+              cs.insert(*data); // fetched upstream
+            }
+            return hit;
+          };
+          for(size_t i = 0; i < requests; i++) {
+            auto rank = catalog.getRank(uniform(gen));
+            contentHits += request(contents[rank - 1]);
+            if(uniform(gen) < certProbability && !request(certs[rank % nProducers])) {
+              certFetches++;
+            }
+          }
+          if(policyName == "lru") {
+            lruCertFetches = certFetches;
+          }
+          auto avoided = static_cast<double>(lruCertFetches) - certFetches;
+          os << csSize << "\t" << policyName << "\t" << static_cast<double>(contentHits) / requests << "\t"
+             << certFetches << "\t" << avoided << "\t" << avoided * upstreamRtt << "\n";
+        }
+      }
+    }
+
+    void CustomBenchmark::merkleBatch(std::ostream &os, const std::vector<size_t> &batchSizes,
+                                      size_t packets) {
+      ::ndn::KeyChain keyChain("pib-memory:", "tpm-memory:");
+      auto identity = keyChain.createIdentity("/zoneA/producer0", ::ndn::RsaKeyParams());
+      auto cert = identity.getDefaultKey().getDefaultCertificate();
+      auto signingInfo = ::ndn::security::signingByIdentity(identity);
+      auto contents = makeContents(packets);
+
+      os << "BatchSize\tSign/s\tVerify/s\tSignSpeedup\tVerifySpeedup\tProofBytes\n";
+      std::pair<double, double> baseline(0.0, 0.0);
+      for(auto batchSize : batchSizes) {
+        size_t failed = 0, proofBytes = 0;
+        std::vector<std::shared_ptr<::ndn::Data>> roots;
+        std::pair<double, double> rates;
+        if(batchSize <= 1) {
+          rates = measureSignVerify(keyChain, identity, contents, failed);
+        } else {
+          // one RSA signature per batch (root Data), the leaves only hash their signed portion
+          rates.first = batchSize * measureOpsPerSecond(packets / batchSize, [&](size_t batch) {
+            ::ndn::Name rootName("/zoneA/producer0/test/prefix/BATCH/0");
+            rootName.appendNumber(batch);
+            std::vector<::ndn::ConstBufferPtr> leaves;
+            for(size_t i = batch * batchSize; i < (batch + 1) * batchSize; i++) {
+              CustomMerkleTree::prepareData(*contents[i], rootName);
+              leaves.push_back(CustomMerkleTree::hashData(*contents[i]));
+            }
+            CustomMerkleTree tree(leaves);
+            auto root = std::make_shared<::ndn::Data>(rootName);
+            root->setContent(tree.getRoot());
+            keyChain.sign(*root, signingInfo);
+            roots.push_back(root);
+            for(size_t i = 0; i < batchSize; i++) {
+              CustomMerkleTree::setProof(*contents[batch * batchSize + i], i, tree.getProof(i));
+            }
+          });
+          // root signature verified once per batch, then one inclusion proof per Data
+          rates.second = batchSize * measureOpsPerSecond(packets / batchSize, [&](size_t batch) {
+            failed += !::ndn::security::verifySignature(*roots[batch], cert);
+            auto rootDigest = roots[batch]->getContent().value();
+            ::ndn::Buffer root(rootDigest, roots[batch]->getContent().value_size());
+            for(size_t i = batch * batchSize; i < (batch + 1) * batchSize; i++) {
+              failed += !CustomMerkleTree::verifyData(*contents[i], root);
+            }
+          });
+          proofBytes = contents[0]->getSignature().getValue().size();
+        }
+        writeSignVerifyRow(os, std::to_string(batchSize), rates, failed, baseline);
+        os << "\t" << proofBytes << "\n";
+      }
+    }
+
+    void CustomBenchmark::groupKey(std::ostream &os, size_t packets) {
+      ::ndn::KeyChain keyChain("pib-memory:", "tpm-memory:");
+      auto contents = makeContents(packets);
+
+      os << "Signature\tSign/s\tVerify/s\tSignSpeedup\tVerifySpeedup\n";
+      std::pair<double, double> baseline(0.0, 0.0);
+      const std::vector<std::pair<std::string, std::shared_ptr<::ndn::KeyParams>>> keyTypes = {
+          {"rsa-sha256", std::make_shared<::ndn::RsaKeyParams>()},
+          {"ecdsa-sha256", std::make_shared<::ndn::EcKeyParams>()},
+      };
+      for(const auto &keyType : keyTypes) {
+        auto identity = keyChain.createIdentity("/zoneA/" + keyType.first, *keyType.second);
+        size_t failed = 0;
+        auto rates = measureSignVerify(keyChain, identity, contents, failed);
+        writeSignVerifyRow(os, keyType.first, rates, failed, baseline);
+        os << "\n";
+      }
+
+      ::ndn::Name keyName("/zoneA/GROUPKEY");
+      keyName.appendVersion(1);
+      auto key = CustomGroupKey::generateKey();
+      size_t failed = 0;
+      std::pair<double, double> rates;
+      rates.first = measureOpsPerSecond(packets, [&](size_t i) {
+        CustomGroupKey::signData(*contents[i], keyName, *key);
+      });
+      rates.second = measureOpsPerSecond(packets, [&](size_t i) {
+        failed += !CustomGroupKey::verifyData(*contents[i], *key);
+      });
+      writeSignVerifyRow(os, "hmac-sha256", rates, failed, baseline);
+      os << "\n";
+    }
+
+    void CustomBenchmark::cryptoPool(std::ostream &os, const std::vector<size_t> &threadCounts,
+                                     size_t packets) {
+      ::ndn::KeyChain keyChain("pib-memory:", "tpm-memory:");
+      auto identity = keyChain.createIdentity("/zoneA/producer0", ::ndn::RsaKeyParams());
+      auto cert = identity.getDefaultKey().getDefaultCertificate();
+      auto privateKey = CustomCryptoPool::exportPrivateKey(keyChain, identity.getDefaultKey());
+      ::ndn::SignatureInfo sigInfo(::ndn::tlv::SignatureSha256WithRsa,
+                                   ::ndn::KeyLocator(identity.getDefaultKey().getName()));
+
+      auto contents = makeContents(packets);
+      for(auto &data : contents) {
+        data->setSignature(::ndn::Signature(sigInfo));
+      }
+
+      // one job per Data, all submitted before waiting (as the jobs of one simulated timestamp)
+      auto &pool = CustomCryptoPool::getInstance();
+      auto previousThreads = pool.getThreads();
+      auto runJobs = [&pool, packets](std::function<void(size_t)> job) {
+        std::vector<std::shared_future<void>> jobs;
+        auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < packets; i++) {
+          jobs.push_back(pool.submit([job, i] { job(i); }));
+        }
+        for(auto &pending : jobs) {
+          pending.get();
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      };
+
+      os << "Threads\tSignWallTime(s)\tSign/s\tVerifyWallTime(s)\tVerify/s\tSignSpeedup\tVerifySpeedup\n";
+      double baseSign = 0.0, baseVerify = 0.0;
+      for(auto threads : threadCounts) {
+        pool.setThreads(threads);
+        std::atomic<size_t> failed(0);
+        double sign = runJobs([&](size_t i) { CustomCryptoPool::signData(*contents[i], *privateKey); });
+        double verify = runJobs([&](size_t i) {
+          if(!::ndn::security::verifySignature(*contents[i], cert)) {
+            failed++;
+          }
+        });
+        if(failed > 0) {
+          os << "WARNING - " << failed << " signatures failed to verify\n";
+        }
+        if(baseSign == 0.0) {
+          baseSign = sign;
+          baseVerify = verify;
+        }
+        os << threads << "\t" << sign << "\t" << packets / sign << "\t" << verify << "\t" << packets / verify
+           << "\t" << baseSign / sign << "\t" << baseVerify / verify << "\n";
+      }
+      pool.setThreads(previousThreads);
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,41 @@
+// custom-benchmark.hpp
+
+#ifndef CUSTOM_BENCHMARK_H_
+#define CUSTOM_BENCHMARK_H_
+
+// system libs
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Headless micro-benchmarks (wall-clock), selected with "--nBenchmark=<name>" in main.cc
+     */
+    class CustomBenchmark {
+    public:
+      /// @brief run benchmark by name, return false if the benchmark is unknown
+      static bool run(const std::string &name, std::ostream &os);
+
+      /// @brief trust schema rule lookup throughput (linear regex scan vs name-prefix index)
+      static void ruleIndex(std::ostream &os, const std::vector<size_t> &producerCounts, size_t lookups);
+
+      /// @brief certificate fetches served by the Content Store (lru, priority_fifo, trust policies)
+      static void csPolicy(std::ostream &os, const std::vector<size_t> &csSizes, size_t requests);
+
+      /// @brief RSA sign/verify throughput of content Data, one signature per Data vs per Merkle batch
+      static void merkleBatch(std::ostream &os, const std::vector<size_t> &batchSizes, size_t packets);
+
+      /// @brief sign/verify throughput of content Data with RSA, ECDSA and zone group key (HMAC) signatures
+      static void groupKey(std::ostream &os, size_t packets);
+
+      /// @brief wall time of RSA sign/verify jobs on CustomCryptoPool against its number of worker threads
+      static void cryptoPool(std::ostream &os, const std::vector<size_t> &threadCounts, size_t packets);
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_BENCHMARK_H_
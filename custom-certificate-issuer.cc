@@ -0,0 +1,31 @@
+// custom-certificate-issuer.cpp
+
+#include "custom-certificate-issuer.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/security/v2/certificate.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    CustomCertificateIssuer::Issuance CustomCertificateIssuer::prepare(const ::ndn::Data &selfSigned,
+                                                                       const ::ndn::name::Component &signerId,
+                                                                       const ::ndn::Name &signPrefix,
+                                                                       ::ndn::time::milliseconds freshness) {
+      auto keyName = ::ndn::security::v2::extractKeyNameFromCertName(selfSigned.getName());
+      Issuance issuance;
+      issuance.certificate = std::make_shared<::ndn::Data>(selfSigned);
+      issuance.certificate->setName(keyName.deepCopy().append(signerId).append(selfSigned.getName().get(-1)));
+      issuance.certificate->setFreshnessPeriod(freshness);
+
+      issuance.response = std::make_shared<::ndn::Data>(signPrefix.deepCopy().append(selfSigned.getName()));
+      issuance.response->setFreshnessPeriod(freshness);
+      return issuance;
+    }
+
+    void CustomCertificateIssuer::setCertificate(const Issuance &issuance) {
+      issuance.response->setContent(issuance.certificate->wireEncode());
+    }
+
+  } // namespace ndn
+} // namespace ns3
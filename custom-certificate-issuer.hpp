@@ -0,0 +1,45 @@
+// custom-certificate-issuer.hpp
+
+#ifndef CUSTOM_CERTIFICATE_ISSUER_H_
+#define CUSTOM_CERTIFICATE_ISSUER_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/data.hpp"
+
+// system libs
+#include <memory>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief SIGN protocol: certificate issued to a producer KEY, and the SIGN response that carries it.
+     *
+     * Only depends on ndn-cxx (shared by CustomTrustAnchor and EmuTrustAnchor); the trust anchor signs the
+     * certificate, then calls setCertificate() and signs the response.
+     */
+    class CustomCertificateIssuer {
+    public:
+      struct Issuance {
+        std::shared_ptr<::ndn::Data> certificate; ///< @brief /<prefix>/KEY/keyID/signerID/versionID
+        std::shared_ptr<::ndn::Data> response;    ///< @brief /<zone>/SIGN/<self-signed certificate name>
+      };
+
+    public:
+      /**
+       * @brief unsigned certificate and SIGN response for the self-signed certificate of a producer
+       *
+       * The certificate keeps the versionID of the self-signed one: a reissue has the same name, so caches
+       * can answer it.
+       */
+      static Issuance prepare(const ::ndn::Data &selfSigned, const ::ndn::name::Component &signerId,
+                              const ::ndn::Name &signPrefix, ::ndn::time::milliseconds freshness);
+
+      /// @brief content of the SIGN response, once the certificate is signed
+      static void setCertificate(const Issuance &issuance);
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_CERTIFICATE_ISSUER_H_
@@ -13,6 +13,7 @@
 #include "ns3/double.h"
 #include "ns3/integer.h"
 #include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
 #include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
@@ -50,11 +51,22 @@ namespace ns3 {
                             "exponential",
                             StringValue("none"),
                             MakeStringAccessor(&CustomConsumer::SetRandomize, &CustomConsumer::GetRandomize),
-                            MakeStringChecker());
+                            MakeStringChecker())
+              .AddAttribute("CatalogSize", "Number of names /<prefix>/<rank> requested (0 = only /<prefix>)",
+                            UintegerValue(0), MakeUintegerAccessor(&CustomConsumer::m_catalogSize),
+                            MakeUintegerChecker<uint32_t>())
+              .AddAttribute("ZipfAlpha", "Zipf-Mandelbrot exponent of the catalog popularity",
+                            DoubleValue(0.7), MakeDoubleAccessor(&CustomConsumer::m_zipfAlpha),
+                            MakeDoubleChecker<double>(0.0))
+              .AddAttribute("ZipfQ", "Zipf-Mandelbrot plateau of the catalog popularity", DoubleValue(0.0),
+                            MakeDoubleAccessor(&CustomConsumer::m_zipfQ), MakeDoubleChecker<double>(0.0))
+              .AddTraceSource("ContentValidated", "First content Data validated by the consumer",
+                              MakeTraceSourceAccessor(&CustomConsumer::m_contentValidatedTrace),
+                              "ns3::ndn::CustomConsumer::ContentValidatedCallback");
       return tid;
     }
 
-    CustomConsumer::CustomConsumer() : CustomApp() {}
+    CustomConsumer::CustomConsumer() : CustomApp(), m_contentValidated(false), m_catalogSize(0) {}
     CustomConsumer::~CustomConsumer() {}
 
     // Processing upon start of the application
@@ -62,35 +74,48 @@ namespace ns3 {
       NS_LOG_FUNCTION_NOARGS();
       ndn::CustomApp::StartApplication();
 
+      // catalog popularity is normalized once, not per Interest
+      if(m_catalogSize > 0) {
+        m_catalog = utils::ZipfMandelbrot(m_catalogSize, m_zipfAlpha, m_zipfQ);
+        m_catalogRank = CreateObject<UniformRandomVariable>();
+      }
+
       // Schedule send of first interest
       scheduleSubscribeSchema();
       scheduleInterestContent();
 
-      // request current trust schema (SCHEMA/CONTENT)
-      InterestOptions opts;
-      opts.canBePrefix = false;
-      opts.mustBeFresh = true;
-      sendInterest(m_schemaContentPrefix, m_schemaSubscribeLifetime, opts);
+      // request current trust schema (SCHEMA/CONTENT) of the own zone and trusted zones
+      requestValidationRules();
     }
 
     // Processing when application is stopped
     void CustomConsumer::StopApplication() {
-      // CUSTOM CLEANUP HERE (if needed)
+      for(const auto &pairTimeout : m_contentTimeouts) {
+        Simulator::Cancel(pairTimeout.second);
+      }
+      m_contentTimeouts.clear();
 
       // cleanup ndn::App
       ndn::CustomApp::StopApplication();
     }
 
-    void CustomConsumer::OnDataContent(std::shared_ptr<const ndn::Data> data) {
+    void CustomConsumer::OnData(std::shared_ptr<const ndn::Data> data) {
+      // content Interests do not use CanBePrefix: the Data name is the Interest name
+      auto it = m_contentTimeouts.find(data->getName());
+      if(it != m_contentTimeouts.end()) {
+        Simulator::Cancel(it->second);
+        m_contentTimeouts.erase(it);
+      }
+      ndn::CustomApp::OnData(data);
+    }
+
+    void CustomConsumer::OnDataContent(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) {
       NS_LOG_FUNCTION(data->getName());
-      if(m_schemaContentPrefix.isPrefixOf(data->getName())) {
-        readValidationRules(data);
-      } else if(m_schemaSubscribePrefix.isPrefixOf(data->getName())) {
-        NS_LOG_INFO("Sending SCHEMA content Interest for '" << m_schemaContentPrefix << "' ... ");
-        InterestOptions opts;
-        opts.canBePrefix = false;
-        opts.mustBeFresh = true;
-        sendInterest(m_schemaContentPrefix, m_schemaSubscribeLifetime, opts);
+      // onData(SCHEMA/CONTENT) or onData(SCHEMA/SUBSCRIBE)
+      if(!OnDataSchema(data) && ctx.validated && !m_contentValidated) {
+        // content Data passed the validator: the consumer trusts the zone
+        m_contentValidated = true;
+        m_contentValidatedTrace(this, data->getName());
       }
     }
 
@@ -128,9 +153,25 @@ namespace ns3 {
     }
 
     void CustomConsumer::sendInterestContent() {
-      sendInterest(m_prefix, m_lifeTime);
+      auto name = m_prefix;
+      if(m_catalogSize > 0) {
+        // /<prefix>/<rank>, rank 1 is the most popular
+        auto rank = m_catalog.getRank(m_catalogRank->GetValue(0.0, 1.0));
+        name = m_prefix.deepCopy().append(std::to_string(rank));
+      }
+      sendInterest(name, m_lifeTime);
+      // a new Interest for a pending name restarts its timeout
+      auto &timeout = m_contentTimeouts[name];
+      Simulator::Cancel(timeout);
+      timeout = Simulator::Schedule(m_lifeTime, &CustomConsumer::OnTimeout, this, name);
       scheduleInterestContent();
     }
 
+    void CustomConsumer::OnTimeout(::ndn::Name name) {
+      NS_LOG_FUNCTION(name);
+      m_contentTimeouts.erase(name);
+      logEvent(CustomEventLog::INTEREST_TIMEOUT);
+    }
+
   } // namespace ndn
 } // namespace ns3
\ No newline at end of file
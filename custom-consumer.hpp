@@ -21,11 +21,16 @@
 
 // custom includes
 #include "custom-app.hpp"
+#include "custom-utils.hpp"
 
 namespace ns3 {
   namespace ndn {
 
     class CustomConsumer : public CustomApp {
+    public:
+      /// @brief first content Data validated by the consumer (consumer app, Data name)
+      typedef void (*ContentValidatedCallback)(Ptr<App> app, const ::ndn::Name &dataName);
+
     public:
       CustomConsumer();
       ~CustomConsumer();
@@ -36,7 +41,8 @@ namespace ns3 {
       void StartApplication() override;
       void StopApplication() override;
 
-      void OnDataContent(std::shared_ptr<const ndn::Data> data) override;
+      void OnData(std::shared_ptr<const ndn::Data> data) override;
+      void OnDataContent(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) override;
 
       /**
        * @brief Set type of frequency randomization
@@ -48,14 +54,26 @@ namespace ns3 {
     private:
       void scheduleInterestContent();
       void sendInterestContent();
+      /// @brief content Interest not answered within its lifetime
+      void OnTimeout(::ndn::Name name);
 
     private:
       ::ndn::Name m_prefix;
+      std::map<::ndn::Name, EventId> m_contentTimeouts; ///< @brief content Interests waiting for Data
       double m_frequency;
       ::ns3::Time m_lifeTime;
       std::string m_randomType;
 
       ::ns3::Ptr<::ns3::RandomVariableStream> m_random; ///< @brief Random generator for packet send
+
+      bool m_contentValidated;
+      TracedCallback<Ptr<App>, const ::ndn::Name &> m_contentValidatedTrace;
+
+      uint32_t m_catalogSize; ///< @brief catalog mode: request /<prefix>/<rank> (0 = only /<prefix>)
+      double m_zipfAlpha;
+      double m_zipfQ;
+      utils::ZipfMandelbrot m_catalog;                       ///< @brief popularity of the catalog ranks
+      ::ns3::Ptr<::ns3::UniformRandomVariable> m_catalogRank; ///< @brief uniform draws mapped to ranks
     };
 
   } // namespace ndn
@@ -0,0 +1,124 @@
+// custom-cpu-model.cpp
+
+#include "custom-cpu-model.hpp"
+#include "custom-merkle-tree.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/tlv.hpp"
+
+// NS3
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
+
+// system libs
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("CustomCpuModel");
+
+namespace ns3 {
+  namespace ndn {
+
+    NS_OBJECT_ENSURE_REGISTERED(CustomCpuModel);
+
+    //////////////////////
+    //     PUBLIC       //
+    //////////////////////
+
+    TypeId CustomCpuModel::GetTypeId() {
+      static TypeId tid =
+          TypeId("CustomCpuModel")
+              .SetParent<Object>()
+              .AddConstructor<CustomCpuModel>()
+              .AddAttribute("Cores", "Number of operations served in parallel", UintegerValue(1),
+                            MakeUintegerAccessor(&CustomCpuModel::m_cores),
+                            MakeUintegerChecker<uint32_t>(1))
+              .AddAttribute("RsaSignCost", "Service time of a RSA signature",
+                            TimeValue(MicroSeconds(1500)), MakeTimeAccessor(&CustomCpuModel::m_rsaSignCost),
+                            MakeTimeChecker())
+              .AddAttribute("RsaVerifyCost", "Service time of a RSA verification",
+                            TimeValue(MicroSeconds(50)), MakeTimeAccessor(&CustomCpuModel::m_rsaVerifyCost),
+                            MakeTimeChecker())
+              .AddAttribute("EcdsaSignCost", "Service time of an ECDSA signature",
+                            TimeValue(MicroSeconds(80)), MakeTimeAccessor(&CustomCpuModel::m_ecdsaSignCost),
+                            MakeTimeChecker())
+              .AddAttribute("EcdsaVerifyCost", "Service time of an ECDSA verification",
+                            TimeValue(MicroSeconds(200)),
+                            MakeTimeAccessor(&CustomCpuModel::m_ecdsaVerifyCost),
+                            MakeTimeChecker())
+              .AddAttribute("HmacCost", "Service time of a HMAC signature/verification",
+                            TimeValue(MicroSeconds(5)), MakeTimeAccessor(&CustomCpuModel::m_hmacCost),
+                            MakeTimeChecker())
+              .AddAttribute("DigestCost", "Service time of a SHA-256 digest signature/verification",
+                            TimeValue(MicroSeconds(2)), MakeTimeAccessor(&CustomCpuModel::m_digestCost),
+                            MakeTimeChecker())
+              .AddTraceSource("BusyCores", "Number of cores serving an operation",
+                              MakeTraceSourceAccessor(&CustomCpuModel::m_busyCores),
+                              "ns3::TracedValueCallback::Uint32")
+              .AddTraceSource("OperationDone", "Operation queued (waiting time and service time)",
+                              MakeTraceSourceAccessor(&CustomCpuModel::m_operationDone),
+                              "ns3::ndn::CustomCpuModel::OperationCallback");
+      return tid;
+    }
+
+    CustomCpuModel::CustomCpuModel() : m_cores(1), m_busyTime(Seconds(0)), m_busyCores(0) {}
+
+    Time CustomCpuModel::getCost(Operation op, uint32_t sigType) const {
+      switch(sigType) {
+        case ::ndn::tlv::SignatureSha256WithRsa:
+          return (op == SIGN ? m_rsaSignCost : m_rsaVerifyCost);
+        case ::ndn::tlv::SignatureSha256WithEcdsa:
+          return (op == SIGN ? m_ecdsaSignCost : m_ecdsaVerifyCost);
+        case ::ndn::tlv::SignatureHmacWithSha256:
+          return m_hmacCost;
+        case ::ndn::tlv::DigestSha256:
+        case CustomMerkleTree::SignatureMerkleSha256: // inclusion proof (a few digests)
+          return m_digestCost;
+      }
+      return Seconds(0);
+    }
+
+    Time CustomCpuModel::execute(Operation op, uint32_t sigType) {
+      if(m_coreFree.size() != m_cores) {
+        m_coreFree.resize(m_cores, Seconds(0));
+      }
+      // FIFO: the operation goes to the core that frees up first
+      auto core = std::min_element(m_coreFree.begin(), m_coreFree.end());
+      Time start = std::max(*core, Simulator::Now());
+      Time cost = getCost(op, sigType);
+      *core = start + cost;
+      m_busyTime += cost;
+      NS_LOG_DEBUG("Operation " << op << " sigType=" << sigType << " waits " << (start - Simulator::Now())
+                                << " served in " << cost);
+
+      if(cost.IsStrictlyPositive()) {
+        Simulator::Schedule(start - Simulator::Now(), &CustomCpuModel::setBusyCores, this, 1);
+        Simulator::Schedule(*core - Simulator::Now(), &CustomCpuModel::setBusyCores, this, -1);
+      }
+      m_operationDone(op, sigType, start - Simulator::Now(), cost);
+      return *core;
+    }
+
+    double CustomCpuModel::getUtilization() const {
+      if(!Simulator::Now().IsStrictlyPositive()) {
+        return 0;
+      }
+      // operations still queued past now do not count
+      Time busyTime = m_busyTime;
+      for(const auto &coreFree : m_coreFree) {
+        if(coreFree > Simulator::Now()) {
+          busyTime -= coreFree - Simulator::Now();
+        }
+      }
+      return busyTime.GetSeconds() / (m_cores * Simulator::Now().GetSeconds());
+    }
+
+    //////////////////////
+    //     PRIVATE      //
+    //////////////////////
+
+    void CustomCpuModel::setBusyCores(int32_t delta) { m_busyCores = m_busyCores.Get() + delta; }
+
+  } // namespace ndn
+} // namespace ns3
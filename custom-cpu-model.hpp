@@ -0,0 +1,68 @@
+// custom-cpu-model.hpp
+
+#ifndef CUSTOM_CPU_MODEL_H_
+#define CUSTOM_CPU_MODEL_H_
+
+// NS3
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+
+// system libs
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Simulated CPU of a node (aggregated to the Node) for sign/verify operations.
+     *
+     * Every operation costs a configurable service time per operation and signature type, and is
+     * served FIFO by the first free core (one core = single server queue). CustomApp delays its
+     * replies until the operations it queued are done, so a saturated trust anchor or producer shows
+     * up as queueing delay instead of signing for free.
+     */
+    class CustomCpuModel : public Object {
+    public:
+      enum Operation { SIGN, VERIFY };
+
+      /// @brief operation done (operation, signature type, time waiting for a core, service time)
+      typedef void (*OperationCallback)(uint32_t op, uint32_t sigType, Time waiting, Time service);
+
+    public:
+      static TypeId GetTypeId();
+
+      CustomCpuModel();
+
+      /// @brief service time of an operation (signature type as in ::ndn::tlv::SignatureTypeValue)
+      Time getCost(Operation op, uint32_t sigType) const;
+
+      /// @brief queue an operation, returns the (absolute) simulated time it completes at
+      Time execute(Operation op, uint32_t sigType);
+
+      /// @brief busy time / (cores * elapsed time) since the start of the simulation
+      double getUtilization() const;
+
+    private:
+      void setBusyCores(int32_t delta);
+
+    private:
+      uint32_t m_cores;
+      Time m_rsaSignCost, m_rsaVerifyCost;
+      Time m_ecdsaSignCost, m_ecdsaVerifyCost;
+      Time m_hmacCost;   ///< @brief sign or verify
+      Time m_digestCost; ///< @brief sign or verify
+
+      std::vector<Time> m_coreFree; ///< @brief time every core finishes its queued operations
+      Time m_busyTime;              ///< @brief service time of all operations (queued ones included)
+
+      TracedValue<uint32_t> m_busyCores;
+      TracedCallback<uint32_t, uint32_t, Time, Time> m_operationDone;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_CPU_MODEL_H_
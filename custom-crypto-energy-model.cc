@@ -0,0 +1,158 @@
+// custom-crypto-energy-model.cpp
+
+#include "custom-crypto-energy-model.hpp"
+#include "custom-merkle-tree.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/tlv.hpp"
+
+// NS3
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+
+// system libs
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("CustomCryptoEnergyModel");
+
+namespace ns3 {
+  namespace ndn {
+
+    NS_OBJECT_ENSURE_REGISTERED(CustomCryptoEnergyModel);
+
+    //////////////////////
+    //     PUBLIC       //
+    //////////////////////
+
+    TypeId CustomCryptoEnergyModel::GetTypeId() {
+      static TypeId tid =
+          TypeId("CustomCryptoEnergyModel")
+              .SetParent<DeviceEnergyModel>()
+              .AddConstructor<CustomCryptoEnergyModel>()
+              .AddAttribute("PulseDuration", "Time the energy of an operation is drawn over (no CPU model)",
+                            TimeValue(MilliSeconds(1)),
+                            MakeTimeAccessor(&CustomCryptoEnergyModel::m_pulseDuration), MakeTimeChecker())
+              .AddAttribute("RsaSignCost", "Energy (J) of a RSA signature", DoubleValue(0.1),
+                            MakeDoubleAccessor(&CustomCryptoEnergyModel::m_rsaSignCost),
+                            MakeDoubleChecker<double>(0))
+              .AddAttribute("RsaVerifyCost", "Energy (J) of a RSA verification", DoubleValue(0.004),
+                            MakeDoubleAccessor(&CustomCryptoEnergyModel::m_rsaVerifyCost),
+                            MakeDoubleChecker<double>(0))
+              .AddAttribute("RsaKeyGenCost", "Energy (J) of a RSA key generation", DoubleValue(2.0),
+                            MakeDoubleAccessor(&CustomCryptoEnergyModel::m_rsaKeyGenCost),
+                            MakeDoubleChecker<double>(0))
+              .AddAttribute("EcdsaSignCost", "Energy (J) of an ECDSA signature", DoubleValue(0.01),
+                            MakeDoubleAccessor(&CustomCryptoEnergyModel::m_ecdsaSignCost),
+                            MakeDoubleChecker<double>(0))
+              .AddAttribute("EcdsaVerifyCost", "Energy (J) of an ECDSA verification", DoubleValue(0.02),
+                            MakeDoubleAccessor(&CustomCryptoEnergyModel::m_ecdsaVerifyCost),
+                            MakeDoubleChecker<double>(0))
+              .AddAttribute("EcdsaKeyGenCost", "Energy (J) of an ECDSA key generation", DoubleValue(0.01),
+                            MakeDoubleAccessor(&CustomCryptoEnergyModel::m_ecdsaKeyGenCost),
+                            MakeDoubleChecker<double>(0))
+              .AddAttribute("HmacCost", "Energy (J) of a HMAC signature/verification/key generation",
+                            DoubleValue(0.00001), MakeDoubleAccessor(&CustomCryptoEnergyModel::m_hmacCost),
+                            MakeDoubleChecker<double>(0))
+              .AddAttribute("DigestCost", "Energy (J) of a SHA-256 digest signature/verification",
+                            DoubleValue(0.000005), MakeDoubleAccessor(&CustomCryptoEnergyModel::m_digestCost),
+                            MakeDoubleChecker<double>(0))
+              .AddTraceSource("TotalEnergyConsumption",
+                              "Energy (J) of all the operations drawn from the energy source",
+                              MakeTraceSourceAccessor(&CustomCryptoEnergyModel::m_totalEnergy),
+                              "ns3::TracedValueCallback::Double")
+              .AddTraceSource("OperationCharged", "Operation charged (energy in J)",
+                              MakeTraceSourceAccessor(&CustomCryptoEnergyModel::m_operationCharged),
+                              "ns3::ndn::CustomCryptoEnergyModel::OperationCallback");
+      return tid;
+    }
+
+    CustomCryptoEnergyModel::CustomCryptoEnergyModel()
+        : m_source(nullptr), m_currentA(0), m_depleted(false), m_totalEnergy(0) {}
+
+    double CustomCryptoEnergyModel::getCost(Operation op, uint32_t sigType) const {
+      switch(sigType) {
+        case ::ndn::tlv::SignatureSha256WithRsa:
+          return (op == SIGN ? m_rsaSignCost : (op == VERIFY ? m_rsaVerifyCost : m_rsaKeyGenCost));
+        case ::ndn::tlv::SignatureSha256WithEcdsa:
+          return (op == SIGN ? m_ecdsaSignCost : (op == VERIFY ? m_ecdsaVerifyCost : m_ecdsaKeyGenCost));
+        case ::ndn::tlv::SignatureHmacWithSha256:
+          return m_hmacCost;
+        case ::ndn::tlv::DigestSha256:
+        case CustomMerkleTree::SignatureMerkleSha256: // inclusion proof (a few digests)
+          return m_digestCost;
+      }
+      return 0;
+    }
+
+    void CustomCryptoEnergyModel::charge(Operation op, uint32_t sigType, Time duration) {
+      double energy = getCost(op, sigType);
+      if(energy <= 0) {
+        return;
+      }
+      // no current drawn without a (charged) source, so nothing consumed either
+      if(m_source == nullptr || m_depleted) {
+        return;
+      }
+      m_totalEnergy = m_totalEnergy.Get() + energy;
+      m_operationCharged(op, sigType, energy);
+      duration = (duration.IsStrictlyPositive() ? duration : m_pulseDuration);
+      // constant current over the pulse: energy = current * voltage * duration
+      double currentA = energy / (m_source->GetSupplyVoltage() * duration.GetSeconds());
+      NS_LOG_DEBUG("Operation " << op << " sigType=" << sigType << " draws " << energy << "J over "
+                                << duration);
+
+      m_source->UpdateEnergySource(); // charge the previous current up to now
+      m_currentA += currentA;
+      Simulator::Schedule(duration, &CustomCryptoEnergyModel::endPulse, this, currentA);
+    }
+
+    uint32_t CustomCryptoEnergyModel::getKeySignatureType(::ndn::KeyType keyType) {
+      switch(keyType) {
+        case ::ndn::KeyType::RSA:
+          return ::ndn::tlv::SignatureSha256WithRsa;
+        case ::ndn::KeyType::EC:
+          return ::ndn::tlv::SignatureSha256WithEcdsa;
+        case ::ndn::KeyType::HMAC:
+          return ::ndn::tlv::SignatureHmacWithSha256;
+        default:
+          return 0;
+      }
+    }
+
+    void CustomCryptoEnergyModel::SetEnergySource(Ptr<EnergySource> source) {
+      NS_ASSERT(source != nullptr);
+      m_source = source;
+    }
+
+    double CustomCryptoEnergyModel::GetTotalEnergyConsumption() const { return m_totalEnergy.Get(); }
+
+    void CustomCryptoEnergyModel::ChangeState(int newState) {} // stateless (current pulses only)
+
+    void CustomCryptoEnergyModel::HandleEnergyDepletion() {
+      NS_LOG_INFO("Energy source depleted, crypto operations are no longer charged to it");
+      m_depleted = true;
+    }
+
+    void CustomCryptoEnergyModel::HandleEnergyRecharged() { m_depleted = false; }
+
+    void CustomCryptoEnergyModel::HandleEnergyChanged() {}
+
+    //////////////////////
+    //     PRIVATE      //
+    //////////////////////
+
+    double CustomCryptoEnergyModel::DoGetCurrentA() const { return m_currentA; }
+
+    void CustomCryptoEnergyModel::DoDispose() { m_source = nullptr; }
+
+    void CustomCryptoEnergyModel::endPulse(double currentA) {
+      if(m_source != nullptr) {
+        m_source->UpdateEnergySource();
+      }
+      m_currentA = std::max(0.0, m_currentA - currentA);
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,83 @@
+// custom-crypto-energy-model.hpp
+
+#ifndef CUSTOM_CRYPTO_ENERGY_MODEL_H_
+#define CUSTOM_CRYPTO_ENERGY_MODEL_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/security/security-common.hpp"
+
+// NS3
+#include "ns3/device-energy-model.h"
+#include "ns3/energy-source.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+
+// system libs
+#include <stdint.h>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Device energy model of the cryptographic operations of a node (sign, verify, key generation).
+     *
+     * Every operation costs a configurable amount of joules per operation and signature/key type. The
+     * energy is drawn from the node energy source as a current pulse (the CustomCpuModel service time of
+     * the operation, or PulseDuration), so it shows up in the remaining/consumed energy of the source.
+     */
+    class CustomCryptoEnergyModel : public DeviceEnergyModel {
+    public:
+      enum Operation { SIGN, VERIFY, KEYGEN };
+
+      /// @brief operation charged (operation, signature type, energy in J)
+      typedef void (*OperationCallback)(uint32_t op, uint32_t sigType, double energy);
+
+    public:
+      static TypeId GetTypeId();
+
+      CustomCryptoEnergyModel();
+
+      /// @brief energy of an operation (signature type as in ::ndn::tlv::SignatureTypeValue)
+      double getCost(Operation op, uint32_t sigType) const;
+
+      /// @brief draw the energy of an operation from the source over duration (0 = PulseDuration)
+      void charge(Operation op, uint32_t sigType, Time duration = Seconds(0));
+
+      /// @brief signature type matching the type of a generated key (::ndn::KeyType)
+      static uint32_t getKeySignatureType(::ndn::KeyType keyType);
+
+      // DeviceEnergyModel
+      void SetEnergySource(Ptr<EnergySource> source) override;
+      double GetTotalEnergyConsumption() const override;
+      void ChangeState(int newState) override;
+      void HandleEnergyDepletion() override;
+      void HandleEnergyRecharged() override;
+      void HandleEnergyChanged() override;
+
+    private:
+      double DoGetCurrentA() const override;
+      void DoDispose() override;
+
+      void endPulse(double currentA);
+
+    private:
+      Ptr<EnergySource> m_source;
+      Time m_pulseDuration;
+
+      double m_rsaSignCost, m_rsaVerifyCost, m_rsaKeyGenCost;
+      double m_ecdsaSignCost, m_ecdsaVerifyCost, m_ecdsaKeyGenCost;
+      double m_hmacCost;   ///< @brief sign or verify
+      double m_digestCost; ///< @brief sign or verify
+
+      double m_currentA; ///< @brief sum of the pulses being drawn
+      bool m_depleted;
+
+      TracedValue<double> m_totalEnergy;
+      TracedCallback<uint32_t, uint32_t, double> m_operationCharged;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_CRYPTO_ENERGY_MODEL_H_
@@ -0,0 +1,110 @@
+// custom-crypto-pool.cpp
+
+#include "custom-crypto-pool.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/block-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/safe-bag.hpp"
+
+// system libs
+#include <string>
+
+namespace ns3 {
+  namespace ndn {
+
+    CustomCryptoPool &CustomCryptoPool::getInstance() {
+      static CustomCryptoPool instance;
+      return instance;
+    }
+
+    CustomCryptoPool::CustomCryptoPool() : m_stop(false) {}
+
+    CustomCryptoPool::~CustomCryptoPool() { stopWorkers(); }
+
+    void CustomCryptoPool::setThreads(size_t threads) {
+      stopWorkers();
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = false;
+      for(size_t i = 0; i < threads; i++) {
+        m_workers.emplace_back(&CustomCryptoPool::runWorker, this);
+      }
+    }
+
+    size_t CustomCryptoPool::getThreads() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_workers.size();
+    }
+
+    std::shared_future<void> CustomCryptoPool::submit(std::function<void()> job) {
+      std::packaged_task<void()> task(std::move(job));
+      auto future = task.get_future().share();
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_workers.empty()) {
+          m_jobs.push_back(std::move(task));
+          m_cv.notify_one();
+          return future;
+        }
+      }
+      // no workers: run it on the caller thread
+      task();
+      return future;
+    }
+
+    std::shared_ptr<const ::ndn::security::transform::PrivateKey>
+    CustomCryptoPool::exportPrivateKey(::ndn::KeyChain &keyChain, const ::ndn::security::pib::Key &key) {
+      // the TPM only hands out private keys encrypted (PKCS#8), with a password that never leaves here
+      const std::string password = "crypto-pool";
+      auto safeBag = keyChain.exportSafeBag(key.getDefaultCertificate(), password.c_str(), password.size());
+      auto &keyBag = safeBag->getEncryptedKeyBag();
+      auto privateKey = std::make_shared<::ndn::security::transform::PrivateKey>();
+      privateKey->loadPkcs8(keyBag.data(), keyBag.size(), password.c_str(), password.size());
+      return privateKey;
+    }
+
+    void CustomCryptoPool::signData(::ndn::Data &data, const ::ndn::security::transform::PrivateKey &key) {
+      ::ndn::EncodingBuffer encoder;
+      data.wireEncode(encoder, true); // signed portion only
+      auto signature = key.sign(encoder.buf(), encoder.size(), ::ndn::DigestAlgorithm::SHA256);
+      data.setSignatureValue(
+          ::ndn::encoding::makeBinaryBlock(::ndn::tlv::SignatureValue, signature->data(), signature->size()));
+      data.wireEncode();
+    }
+
+    //////////////////////
+    //     PRIVATE      //
+    //////////////////////
+
+    void CustomCryptoPool::stopWorkers() {
+      std::vector<std::thread> workers;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        workers.swap(m_workers);
+      }
+      m_cv.notify_all();
+      for(auto &worker : workers) {
+        worker.join();
+      }
+    }
+
+    void CustomCryptoPool::runWorker() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while(true) {
+        m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if(m_jobs.empty()) { // m_stop
+          return;
+        }
+        auto task = std::move(m_jobs.front());
+        m_jobs.pop_front();
+
+        // run the job without holding the lock (exceptions are stored in its future)
+        lock.unlock();
+        task();
+        lock.lock();
+      }
+    }
+
+  } // namespace ndn
+} // namespace ns3
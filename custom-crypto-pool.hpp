@@ -0,0 +1,73 @@
+// custom-crypto-pool.hpp
+
+#ifndef CUSTOM_CRYPTO_POOL_H_
+#define CUSTOM_CRYPTO_POOL_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/data.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/key-chain.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/transform/private-key.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/certificate.hpp"
+
+// system libs
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Process-wide pool of worker threads running real crypto jobs (signing, signature verification)
+     * off the simulator thread.
+     *
+     * Jobs only do the wall-clock work: the simulator thread waits for a job at a simulated completion time
+     * fixed when it was submitted (see CustomApp::signAsync), so the results do not depend on the number
+     * of threads or on their scheduling. With 0 threads, jobs run inline when submitted (CustomApp only
+     * submits them at their completion time then).
+     *
+     * Jobs never use a KeyChain (not thread-safe): they sign with a private key handle exported once on the
+     * simulator thread (exportPrivateKey), which every signature only reads through its own OpenSSL context.
+     */
+    class CustomCryptoPool {
+    public:
+      static CustomCryptoPool &getInstance();
+
+      ~CustomCryptoPool();
+
+      /// @brief (re)start the pool with the given number of worker threads (queued jobs are run first)
+      void setThreads(size_t threads);
+      size_t getThreads();
+
+      /// @brief queue a job, the future rethrows its exception (if any)
+      std::shared_future<void> submit(std::function<void()> job);
+
+      /// @brief private key of a KeyChain key (from its default certificate), for signData()
+      static std::shared_ptr<const ::ndn::security::transform::PrivateKey>
+      exportPrivateKey(::ndn::KeyChain &keyChain, const ::ndn::security::pib::Key &key);
+
+      /// @brief sign (and encode) data with a private key, its SignatureInfo must already be set
+      static void signData(::ndn::Data &data, const ::ndn::security::transform::PrivateKey &key);
+
+    private:
+      CustomCryptoPool();
+
+      void stopWorkers();
+      void runWorker();
+
+    private:
+      std::mutex m_mutex;
+      std::condition_variable m_cv;
+      std::deque<std::packaged_task<void()>> m_jobs;
+      bool m_stop;
+      std::vector<std::thread> m_workers;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_CRYPTO_POOL_H_
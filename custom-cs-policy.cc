@@ -0,0 +1,126 @@
+// custom-cs-policy.cpp
+
+#include "custom-cs-policy.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/security/v2/certificate.hpp"
+
+// NDNSIM NFD
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    const std::string CustomCsPolicy::POLICY_NAME = "trust";
+    const ::ndn::time::seconds CustomCsPolicy::PIN_LIFETIME(60);
+
+    CustomCsPolicy::CustomCsPolicy() : ::nfd::cs::Policy(POLICY_NAME) {}
+
+    bool CustomCsPolicy::isTrustData(const ::ndn::Name &name) {
+      static const ::ndn::name::Component SCHEMA("SCHEMA");
+      static const ::ndn::name::Component SIGN("SIGN");
+      for(const auto &component : name) {
+        if(component == ::ndn::security::v2::Certificate::KEY_COMPONENT || component == SCHEMA ||
+           component == SIGN) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //////////////////////
+    //     PRIVATE
+    //////////////////////
+
+    void CustomCsPolicy::doAfterInsert(EntryRef i) {
+      insertToQueue(i);
+      evictEntries();
+    }
+
+    void CustomCsPolicy::doAfterRefresh(EntryRef i) {
+      // new Data for the same name: expiry computed again
+      eraseFromQueue(i);
+      insertToQueue(i);
+    }
+
+    void CustomCsPolicy::doBeforeErase(EntryRef i) { eraseFromQueue(i); }
+
+    void CustomCsPolicy::doBeforeUse(EntryRef i) { moveToBack(i); }
+
+    void CustomCsPolicy::evictEntries() {
+      BOOST_ASSERT(getCs() != nullptr);
+      while(getCs()->size() > getLimit()) {
+        // 1. trust Data no longer useful (earliest expiry), 2. other Data (LRU), 3. trust Data (LRU)
+        if(!m_expiries.empty() && m_expiries.begin()->first <= ::ndn::time::system_clock::now()) {
+          evict(m_expiries.begin()->second);
+        } else if(!m_regular.empty()) {
+          evict(m_regular.front());
+        } else {
+          BOOST_ASSERT(!m_pinned.empty());
+          evict(m_pinned.front());
+        }
+      }
+    }
+
+    /// @brief insert entry at the back (most recently used) of its queue
+    void CustomCsPolicy::insertToQueue(EntryRef i) {
+      Item item;
+      item.pinned = isTrustData(i->getName());
+      item.hasValidity = false;
+      auto &queue = (item.pinned ? m_pinned : m_regular);
+      item.position = queue.insert(queue.end(), i);
+      if(item.pinned) {
+        auto pinnedUntil = ::ndn::time::system_clock::now() + PIN_LIFETIME;
+        if(::ndn::security::v2::Certificate::isValidName(i->getName())) {
+          try {
+            ::ndn::security::v2::Certificate cert(i->getData());
+            pinnedUntil = cert.getValidityPeriod().getPeriod().second;
+            item.hasValidity = true;
+          } catch(const std::exception &e) {
+            // not a certificate after all (e.g. SIGN response), keep PIN_LIFETIME
+          }
+        }
+        item.expiry = m_expiries.emplace(pinnedUntil, i);
+      }
+      m_items[&*i] = item;
+    }
+
+    /// @brief Content Store hit: entry becomes the most recently used of its queue
+    void CustomCsPolicy::moveToBack(EntryRef i) {
+      auto it = m_items.find(&*i);
+      if(it == m_items.end()) {
+        insertToQueue(i);
+        return;
+      }
+      auto &item = it->second;
+      auto &queue = (item.pinned ? m_pinned : m_regular);
+      queue.splice(queue.end(), queue, item.position);
+      if(item.pinned && !item.hasValidity) {
+        // trust Data still in use (e.g. SCHEMA manifest) stays pinned for another PIN_LIFETIME
+        m_expiries.erase(item.expiry);
+        item.expiry = m_expiries.emplace(::ndn::time::system_clock::now() + PIN_LIFETIME, i);
+      }
+    }
+
+    void CustomCsPolicy::eraseFromQueue(EntryRef i) {
+      auto it = m_items.find(&*i);
+      if(it == m_items.end()) {
+        return;
+      }
+      auto &item = it->second;
+      if(item.pinned) {
+        m_pinned.erase(item.position);
+        m_expiries.erase(item.expiry);
+      } else {
+        m_regular.erase(item.position);
+      }
+      m_items.erase(it);
+    }
+
+    void CustomCsPolicy::evict(EntryRef i) {
+      eraseFromQueue(i);
+      emitSignal(beforeEvict, i);
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,73 @@
+// custom-cs-policy.hpp
+
+#ifndef CUSTOM_CS_POLICY_H_
+#define CUSTOM_CS_POLICY_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/time.hpp"
+
+// NDNSIM NFD
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy.hpp"
+
+// system libs
+#include <list>
+#include <map>
+#include <string>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Content Store policy that keeps trust Data (certificates, SCHEMA, SIGN responses) cached.
+     *
+     * Entries are kept in two LRU queues. Trust Data is only evicted when no other entry is left, or once
+     * it is no longer useful: past the validity period of a certificate, or PIN_LIFETIME for SCHEMA Data.
+     * The expiry is computed when the Data is inserted (or refreshed) and kept in an ordered index, so
+     * Content Store hits and evictions do not parse certificates nor scan the queues.
+     * Selected with "--nCsPolicy=trust" in main.cc.
+     */
+    class CustomCsPolicy : public ::nfd::cs::Policy {
+    public:
+      CustomCsPolicy();
+
+      /// @brief certificate (KEY), SCHEMA or SIGN Data
+      static bool isTrustData(const ::ndn::Name &name);
+
+    public:
+      static const std::string POLICY_NAME;
+      static const ::ndn::time::seconds PIN_LIFETIME; ///< @brief for trust Data without validity period
+
+    private:
+      void doAfterInsert(EntryRef i) final;
+      void doAfterRefresh(EntryRef i) final;
+      void doBeforeErase(EntryRef i) final;
+      void doBeforeUse(EntryRef i) final;
+      void evictEntries() final;
+
+    private:
+      using ExpiryIndex = std::multimap<::ndn::time::system_clock::TimePoint, EntryRef>;
+
+      struct Item {
+        bool pinned;
+        bool hasValidity; ///< @brief pinned until the end of a certificate validity period
+        std::list<EntryRef>::iterator position;
+        ExpiryIndex::iterator expiry; ///< @brief pinned entries only
+      };
+
+      void insertToQueue(EntryRef i);
+      void moveToBack(EntryRef i);
+      void eraseFromQueue(EntryRef i);
+      void evict(EntryRef i);
+
+    private:
+      std::list<EntryRef> m_pinned;                      ///< @brief trust Data, LRU order
+      std::list<EntryRef> m_regular;                     ///< @brief other Data, LRU order
+      ExpiryIndex m_expiries;                            ///< @brief pinned entries, by end of pin
+      std::map<const ::nfd::cs::Entry *, Item> m_items; ///< @brief CS entries have stable addresses
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_CS_POLICY_H_
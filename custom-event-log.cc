@@ -0,0 +1,182 @@
+// custom-event-log.cpp
+
+#include "custom-event-log.hpp"
+
+// NS3
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+// NDNSIM
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+// system libs
+#include <algorithm>
+#include <stdexcept> // for standard exception classes
+
+NS_LOG_COMPONENT_DEFINE("CustomEventLog");
+
+namespace ns3 {
+  namespace ndn {
+
+    const char CustomEventLog::MAGIC[8] = {'B', 'S', 'E', 'V', 'T', 'L', 'O', 'G'};
+
+    namespace {
+      /// @brief app and internal faces are local: readLogfile.py skips them too
+      bool isNetworkFace(const ::nfd::face::Face &face) {
+        return face.getScope() != ::ndn::nfd::FACE_SCOPE_LOCAL;
+      }
+
+      /// @brief NFD management (/localhost/nfd) is not counted by readLogfile.py
+      bool isLocalhost(const ::ndn::Name &name) {
+        static const ::ndn::Name localhost("/localhost");
+        return localhost.isPrefixOf(name);
+      }
+    } // namespace
+
+    /// @brief forwarder events of one node (see traceForwarder)
+    struct CustomEventLog::ForwarderTrace {
+      uint32_t node;
+      const ::ndn::Data *satisfiedData; ///< @brief Data that satisfied a PIT entry, until its InData trace
+
+      explicit ForwarderTrace(uint32_t node) : node(node), satisfiedData(nullptr) {}
+
+      void log(Type type, uint64_t value = 0) {
+        CustomEventLog::getInstance().record(Simulator::Now(), node, type, value);
+      }
+
+      void onInInterest(const ::ndn::Interest &, const ::nfd::face::Face &face) {
+        if(isNetworkFace(face)) {
+          log(FWD_INTEREST_IN);
+        }
+      }
+
+      void onInData(const ::ndn::Data &data, const ::nfd::face::Face &face) {
+        // the forwarder connected to the face first: it already processed this Data (see onSatisfy)
+        bool unsolicited = &data != satisfiedData;
+        satisfiedData = nullptr;
+        if(isNetworkFace(face)) {
+          log(FWD_DATA_IN, data.getContent().value_size());
+          if(unsolicited) {
+            log(FWD_DATA_UNSOLICITED);
+          }
+        }
+      }
+
+      void onOutData(const ::ndn::Data &data, const ::nfd::face::Face &face) {
+        if(isNetworkFace(face)) {
+          log(FWD_DATA_OUT, data.getContent().value_size());
+        }
+      }
+
+      void onOutNack(const ::ndn::lp::Nack &nack, const ::nfd::face::Face &face) {
+        if(isNetworkFace(face)) {
+          log(FWD_NACK_OUT, static_cast<uint64_t>(nack.getReason()));
+        }
+      }
+
+      void onSatisfy(const ::nfd::pit::Entry &entry, const ::ndn::Data &data) {
+        satisfiedData = &data;
+        if(!isLocalhost(entry.getName())) {
+          log(FWD_SATISFIED);
+        }
+      }
+
+      void logNamed(Type type, const ::ndn::Name &name) {
+        if(!isLocalhost(name)) {
+          log(type);
+        }
+      }
+    };
+
+    CustomEventLog &CustomEventLog::getInstance() {
+      static CustomEventLog instance;
+      return instance;
+    }
+
+    CustomEventLog::CustomEventLog() : m_count(0) {}
+
+    void CustomEventLog::open(const std::string &filename, size_t capacity) {
+      close();
+      m_file.open(filename, std::ios::binary | std::ios::trunc);
+      if(!m_file) {
+        throw std::runtime_error("Failed to open event log file='" + filename + "'");
+      }
+      uint32_t header[2] = {FORMAT_VERSION, sizeof(Record)};
+      m_file.write(MAGIC, sizeof(MAGIC));
+      m_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+      m_ring.assign(std::max<size_t>(capacity, 1), Record());
+      m_count = 0;
+      NS_LOG_INFO("Logging events to '" << filename << "' (" << m_ring.size() << " records buffered)");
+    }
+
+    void CustomEventLog::close() {
+      if(!m_file.is_open()) {
+        return;
+      }
+      flush();
+      m_file.close();
+      m_ring.clear();
+      m_ring.shrink_to_fit();
+    }
+
+    bool CustomEventLog::isOpen() const { return m_file.is_open(); }
+
+    void CustomEventLog::record(Time time, uint32_t node, Type type, uint64_t value) {
+      if(!m_file.is_open()) {
+        return;
+      }
+      auto &record = m_ring[m_count++];
+      record.time = time.GetNanoSeconds();
+      record.node = node;
+      record.type = type;
+      record.flags = 0;
+      record.value = value;
+      if(m_count == m_ring.size()) {
+        flush();
+      }
+    }
+
+    void CustomEventLog::traceForwarder(Ptr<Node> node) {
+      auto l3 = node->GetObject<L3Protocol>();
+      if(l3 == nullptr) {
+        return; // no NDN stack
+      }
+      auto trace = std::make_shared<ForwarderTrace>(node->GetId());
+      m_forwarders.push_back(trace);
+
+      // packets on the faces
+      l3->TraceConnectWithoutContext("InInterests", MakeCallback(&ForwarderTrace::onInInterest, trace.get()));
+      l3->TraceConnectWithoutContext("InData", MakeCallback(&ForwarderTrace::onInData, trace.get()));
+      l3->TraceConnectWithoutContext("OutData", MakeCallback(&ForwarderTrace::onOutData, trace.get()));
+      l3->TraceConnectWithoutContext("OutNack", MakeCallback(&ForwarderTrace::onOutNack, trace.get()));
+
+      // Content Store and PIT
+      auto forwarder = l3->getForwarder();
+      forwarder->afterCsHit.connect([trace](const ::ndn::Interest &interest, const ::ndn::Data &) {
+        trace->logNamed(CS_HIT, interest.getName());
+      });
+      forwarder->afterCsMiss.connect(
+          [trace](const ::ndn::Interest &interest) { trace->logNamed(CS_MISS, interest.getName()); });
+      forwarder->beforeSatisfyInterest.connect(
+          [trace](const ::nfd::pit::Entry &entry, const ::nfd::face::Face &, const ::ndn::Data &data) {
+            trace->onSatisfy(entry, data);
+          });
+      forwarder->beforeExpirePendingInterest.connect(
+          [trace](const ::nfd::pit::Entry &entry) { trace->logNamed(FWD_UNSATISFIED, entry.getName()); });
+    }
+
+    //////////////////////
+    //     PRIVATE      //
+    //////////////////////
+
+    void CustomEventLog::flush() {
+      m_file.write(reinterpret_cast<const char *>(m_ring.data()), m_count * sizeof(Record));
+      m_count = 0;
+      if(!m_file) {
+        throw std::runtime_error("Failed to write event log - Error=write failed");
+      }
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,102 @@
+// custom-event-log.hpp
+
+#ifndef CUSTOM_EVENT_LOG_H_
+#define CUSTOM_EVENT_LOG_H_
+
+// NS3
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+// system libs
+#include <fstream>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+  class Node;
+
+  namespace ndn {
+
+    /**
+     * @brief Binary log of the forwarder and app events (packets, Content Store, PIT, validation,
+     * enrollment, SCHEMA), decoded offline.
+     *
+     * Replaces scraping NS_LOG text: the forwarders (see traceForwarder) and the apps record fixed-size
+     * events into a ring of Capacity records, written to the file in one block every time it wraps around
+     * (and on close), so runs keep logging off. Disabled (record() returns at once) unless open() was
+     * called. readEventLog.py builds the per-second table of readLogfile.py (results/data.dat) and the
+     * security events table from it.
+     *
+     * File: "BSEVTLOG" magic, uint32 format version, uint32 record size, then the records (host byte order).
+     */
+    class CustomEventLog {
+    public:
+      enum Type : uint16_t {
+        INTEREST_IN = 1,
+        INTEREST_OUT = 2,
+        DATA_IN = 3,
+        DATA_OUT = 4,
+        NACK_IN = 5,
+        NACK_OUT = 6,
+        VALIDATED = 7,
+        VALIDATION_FAILED = 8,
+        ENROLLED = 9,      ///< @brief producer got its certificate (value = SIGN Interests sent)
+        CERT_ISSUED = 10,  ///< @brief trust anchor signed a producer KEY
+        SCHEMA_UPDATE = 11, ///< @brief SCHEMA version served (trust anchor) or loaded (validators)
+        // forwarder (packets on the non-local faces, as readLogfile.py counts them)
+        FWD_INTEREST_IN = 12,
+        FWD_DATA_IN = 13,
+        FWD_DATA_OUT = 14,
+        FWD_DATA_UNSOLICITED = 15, ///< @brief incoming Data that satisfied no PIT entry
+        FWD_NACK_OUT = 16,
+        FWD_SATISFIED = 17,   ///< @brief PIT entry satisfied
+        FWD_UNSATISFIED = 18, ///< @brief PIT entry expired unsatisfied
+        CS_HIT = 19,
+        CS_MISS = 20,
+        INTEREST_TIMEOUT = 21 ///< @brief consumer Interest not answered within its lifetime
+      };
+
+#pragma pack(push, 1)
+      struct Record {
+        uint64_t time;  ///< @brief simulation time (ns)
+        uint32_t node;  ///< @brief node id
+        uint16_t type;  ///< @brief Type
+        uint16_t flags; ///< @brief reserved (0)
+        uint64_t value; ///< @brief content size (DATA_IN/OUT), Nack reason, error code, SCHEMA version, ...
+      };
+#pragma pack(pop)
+
+      static const char MAGIC[8];
+      static const uint32_t FORMAT_VERSION = 1;
+
+    public:
+      static CustomEventLog &getInstance();
+
+      void open(const std::string &filename, size_t capacity = 65536);
+      void close();
+      bool isOpen() const;
+
+      void record(Time time, uint32_t node, Type type, uint64_t value = 0);
+
+      /// @brief record the forwarder events of the node (call once per node, before the simulation runs)
+      void traceForwarder(Ptr<Node> node);
+
+    private:
+      struct ForwarderTrace;
+
+      CustomEventLog();
+      void flush();
+
+    private:
+      std::ofstream m_file;
+      std::vector<Record> m_ring;
+      size_t m_count; ///< @brief records in the ring (not written yet)
+      std::vector<std::shared_ptr<ForwarderTrace>> m_forwarders;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_EVENT_LOG_H_
@@ -0,0 +1,95 @@
+// custom-group-key.cpp
+
+#include "custom-group-key.hpp"
+#include "custom-schema-tlv.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/block-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/buffer-stream.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/transform/buffer-source.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/transform/hmac-filter.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/transform/public-key.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/transform/stream-sink.hpp"
+#include "ns3/ndnSIM/ndn-cxx/signature.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/random.hpp"
+
+// system libs
+#include <stdexcept> // for standard exception classes
+
+namespace ns3 {
+  namespace ndn {
+
+    const size_t CustomGroupKey::KEY_SIZE = 32;
+
+    ::ndn::ConstBufferPtr CustomGroupKey::generateKey() {
+      auto key = std::make_shared<::ndn::Buffer>(KEY_SIZE);
+      ::ndn::random::generateSecureBytes(key->data(), key->size());
+      return key;
+    }
+
+    void CustomGroupKey::signData(::ndn::Data &data, const ::ndn::Name &keyName, const ::ndn::Buffer &key) {
+      ::ndn::SignatureInfo sigInfo(::ndn::tlv::SignatureHmacWithSha256, ::ndn::KeyLocator(keyName));
+      data.setSignature(::ndn::Signature(sigInfo));
+      auto hmac = computeHmac(data, key);
+      data.setSignatureValue(
+          ::ndn::encoding::makeBinaryBlock(::ndn::tlv::SignatureValue, hmac->data(), hmac->size()));
+    }
+
+    bool CustomGroupKey::verifyData(const ::ndn::Data &data, const ::ndn::Buffer &key) {
+      if(data.getSignature().getType() != ::ndn::tlv::SignatureHmacWithSha256) {
+        return false;
+      }
+      auto hmac = computeHmac(data, key);
+      auto &value = data.getSignature().getValue();
+      if(value.value_size() != hmac->size()) {
+        return false;
+      }
+      // constant time comparison
+      uint8_t diff = 0;
+      for(size_t i = 0; i < hmac->size(); i++) {
+        diff |= (value.value()[i] ^ (*hmac)[i]);
+      }
+      return (diff == 0);
+    }
+
+    ::ndn::Block CustomGroupKey::encryptKey(const ::ndn::Name &keyName, const ::ndn::Buffer &key,
+                                            const ::ndn::security::v2::Certificate &cert) {
+      auto publicKeyBits = cert.getPublicKey();
+      ::ndn::security::transform::PublicKey publicKey;
+      publicKey.loadPkcs8(publicKeyBits.data(), publicKeyBits.size());
+      auto encryptedKey = publicKey.encrypt(key.data(), key.size());
+
+      ::ndn::Block block(CustomSchemaTlv::GroupKey);
+      block.push_back(keyName.wireEncode());
+      block.push_back(::ndn::encoding::makeBinaryBlock(CustomSchemaTlv::EncryptedKey, encryptedKey->data(),
+                                                       encryptedKey->size()));
+      block.encode();
+      return block;
+    }
+
+    std::pair<::ndn::Name, ::ndn::Block> CustomGroupKey::decodeKey(const ::ndn::Block &block) {
+      if(block.type() != CustomSchemaTlv::GroupKey) {
+        throw std::runtime_error("Unexpected TLV-TYPE " + std::to_string(block.type()) + " for group key");
+      }
+      block.parse();
+      ::ndn::Name keyName(block.get(::ndn::tlv::Name));
+      return std::make_pair(keyName, block.get(CustomSchemaTlv::EncryptedKey));
+    }
+
+    //////////////////////
+    //     PRIVATE
+    //////////////////////
+
+    ::ndn::ConstBufferPtr CustomGroupKey::computeHmac(const ::ndn::Data &data, const ::ndn::Buffer &key) {
+      ::ndn::EncodingBuffer encoder;
+      data.wireEncode(encoder, true); // signed portion only
+      ::ndn::OBufferStream os;
+      ::ndn::security::transform::bufferSource(encoder.buf(), encoder.size()) >>
+          ::ndn::security::transform::hmacFilter(::ndn::DigestAlgorithm::SHA256, key.data(), key.size()) >>
+          ::ndn::security::transform::streamSink(os);
+      return os.buf();
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,54 @@
+// custom-group-key.hpp
+
+#ifndef CUSTOM_GROUP_KEY_H_
+#define CUSTOM_GROUP_KEY_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/data.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/block.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/buffer.hpp"
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/certificate.hpp"
+
+// system libs
+#include <stdint.h>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Zone group key: symmetric HMAC-SHA256 key shared by the enrolled producers of a zone.
+     *
+     * The trust anchor generates the key and hands it to each enrolled producer encrypted with the
+     * producer KEY (RSA-OAEP), in a Data signed by the zone KEY. Producers then sign content Data with
+     * SignatureHmacWithSha256 and a KeyLocator with the group key name, and validators that hold the key
+     * check the HMAC instead of fetching a certificate chain. Any holder of the key can sign for the zone.
+     *
+     * Only depends on ndn-cxx, so it can be reused outside of ns-3.
+     */
+    class CustomGroupKey {
+    public:
+      static const size_t KEY_SIZE; ///< @brief bytes of a generated group key
+
+    public:
+      static ::ndn::ConstBufferPtr generateKey();
+
+      /// @brief sign the Data with HMAC-SHA256 (KeyLocator = group key name)
+      static void signData(::ndn::Data &data, const ::ndn::Name &keyName, const ::ndn::Buffer &key);
+      /// @brief true if the HMAC of the signed portion of the Data matches its SignatureValue
+      static bool verifyData(const ::ndn::Data &data, const ::ndn::Buffer &key);
+
+      /// @brief group key name and key encrypted with the public key of the certificate (RSA only)
+      static ::ndn::Block encryptKey(const ::ndn::Name &keyName, const ::ndn::Buffer &key,
+                                     const ::ndn::security::v2::Certificate &cert);
+      /// @brief group key name and encrypted key (to be decrypted with the TPM of the recipient)
+      static std::pair<::ndn::Name, ::ndn::Block> decodeKey(const ::ndn::Block &block);
+
+    private:
+      static ::ndn::ConstBufferPtr computeHmac(const ::ndn::Data &data, const ::ndn::Buffer &key);
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_GROUP_KEY_H_
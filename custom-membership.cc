@@ -0,0 +1,131 @@
+// custom-membership.cpp
+
+#include "custom-membership.hpp"
+
+#include "custom-utils.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/util/string-helper.hpp"
+
+// system libs
+#include <algorithm>
+#include <stdexcept> // for standard exception classes
+
+namespace ns3 {
+  namespace ndn {
+
+    CustomMembershipSet::CustomMembershipSet(Type type, size_t bloomBits, size_t bloomHashes)
+        : m_type(type), m_bloomHashes(bloomHashes), m_bloom((type == BLOOM ? (bloomBits + 7) / 8 : 0), 0),
+          m_bloomCount(0) {
+      if(m_type == BLOOM && (bloomBits == 0 || bloomHashes == 0)) {
+        throw std::runtime_error("Bloom filter membership requires bits > 0 and hashes > 0");
+      }
+    }
+
+    void CustomMembershipSet::insert(const ::ndn::Name &identity) {
+      if(m_type == BLOOM) {
+        if(!hasBloomBits(identity.toUri())) {
+          m_bloomCount++;
+        }
+        setBloomBits(identity.toUri());
+        return;
+      }
+      auto it = std::lower_bound(m_identities.begin(), m_identities.end(), identity);
+      if(it == m_identities.end() || *it != identity) {
+        m_identities.insert(it, identity);
+      }
+    }
+
+    bool CustomMembershipSet::contains(const ::ndn::Name &identity) const {
+      if(m_type == BLOOM) {
+        return hasBloomBits(identity.toUri());
+      }
+      return std::binary_search(m_identities.begin(), m_identities.end(), identity);
+    }
+
+    CustomMembershipSet::Type CustomMembershipSet::getType() const { return m_type; }
+
+    size_t CustomMembershipSet::size() const {
+      return (m_type == BLOOM ? m_bloomCount : m_identities.size());
+    }
+
+    void CustomMembershipSet::setZone(const ::ndn::Name &zone) { m_zone = zone; }
+    const ::ndn::Name &CustomMembershipSet::getZone() const { return m_zone; }
+
+    ::ndn::security::v2::validator_config::ConfigSection CustomMembershipSet::toConfigSection() const {
+      ::ndn::security::v2::validator_config::ConfigSection section;
+      if(!m_zone.empty()) {
+        section.put("zone", m_zone.toUri());
+      }
+      if(m_type == BLOOM) {
+        section.put("type", "bloom");
+        section.put("hashes", m_bloomHashes);
+        section.put("count", m_bloomCount);
+        section.put("filter", ::ndn::toHex(m_bloom.data(), m_bloom.size()));
+      } else {
+        section.put("type", "list");
+        for(const auto &identity : m_identities) {
+          section.add("id", identity.toUri());
+        }
+      }
+      return section;
+    }
+
+    CustomMembershipSet CustomMembershipSet::fromConfigSection(
+        const ::ndn::security::v2::validator_config::ConfigSection &section) {
+      auto type = parseType(section.get<std::string>("type", "list"));
+      ::ndn::Name zone(section.get<std::string>("zone", "/"));
+      if(type == BLOOM) {
+        auto filter = ::ndn::fromHex(section.get<std::string>("filter"));
+        CustomMembershipSet membership(BLOOM, filter->size() * 8, section.get<size_t>("hashes"));
+        std::copy(filter->begin(), filter->end(), membership.m_bloom.begin());
+        membership.m_bloomCount = section.get<size_t>("count", 0);
+        membership.setZone(zone);
+        return membership;
+      }
+      CustomMembershipSet membership(LIST);
+      membership.setZone(zone);
+      for(const auto &item : section) {
+        if(item.first == "id") {
+          membership.insert(::ndn::Name(item.second.get_value<std::string>()));
+        }
+      }
+      return membership;
+    }
+
+    CustomMembershipSet::Type CustomMembershipSet::parseType(const std::string &type) {
+      if(type == "list") {
+        return LIST;
+      } else if(type == "bloom") {
+        return BLOOM;
+      }
+      throw std::runtime_error("Unknown membership type '" + type + "'");
+    }
+
+    //////////////////////
+    //     PRIVATE
+    //////////////////////
+
+    void CustomMembershipSet::setBloomBits(const std::string &identity) {
+      uint64_t h1 = utils::fnv1a(identity), h2 = utils::fnv1a(identity, h1) | 1;
+      size_t nBits = m_bloom.size() * 8;
+      for(size_t i = 0; i < m_bloomHashes; i++) {
+        size_t bit = (h1 + i * h2) % nBits;
+        m_bloom[bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
+      }
+    }
+
+    bool CustomMembershipSet::hasBloomBits(const std::string &identity) const {
+      uint64_t h1 = utils::fnv1a(identity), h2 = utils::fnv1a(identity, h1) | 1;
+      size_t nBits = m_bloom.size() * 8;
+      for(size_t i = 0; i < m_bloomHashes; i++) {
+        size_t bit = (h1 + i * h2) % nBits;
+        if(!(m_bloom[bit / 8] & (1 << (bit % 8)))) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  } // namespace ndn
+} // namespace ns3
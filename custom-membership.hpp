@@ -0,0 +1,63 @@
+// custom-membership.hpp
+
+#ifndef CUSTOM_MEMBERSHIP_H_
+#define CUSTOM_MEMBERSHIP_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validator-config/common.hpp"
+
+// system libs
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Set of identities enrolled in a zone.
+     *
+     * Distributed as the "membership" section of the trust schema, either as a sorted identity list
+     * (exact) or as a Bloom filter (constant size, false positives possible). The section names its zone,
+     * so only the rules of that zone accept its members once the schemas of several zones are merged.
+     */
+    class CustomMembershipSet {
+    public:
+      enum Type { LIST, BLOOM };
+
+    public:
+      CustomMembershipSet(Type type = LIST, size_t bloomBits = 8192, size_t bloomHashes = 4);
+
+      void insert(const ::ndn::Name &identity);
+      bool contains(const ::ndn::Name &identity) const;
+
+      Type getType() const;
+      size_t size() const;
+
+      void setZone(const ::ndn::Name &zone);
+      const ::ndn::Name &getZone() const;
+
+      ::ndn::security::v2::validator_config::ConfigSection toConfigSection() const;
+      static CustomMembershipSet
+      fromConfigSection(const ::ndn::security::v2::validator_config::ConfigSection &section);
+
+      static Type parseType(const std::string &type);
+
+    private:
+      void setBloomBits(const std::string &identity);
+      bool hasBloomBits(const std::string &identity) const;
+
+    private:
+      Type m_type;
+      ::ndn::Name m_zone;                    ///< @brief zone of the identities (empty = any zone)
+      std::vector<::ndn::Name> m_identities; ///< @brief sorted identities (LIST)
+      size_t m_bloomHashes;
+      std::vector<uint8_t> m_bloom; ///< @brief Bloom filter bits (BLOOM)
+      size_t m_bloomCount;          ///< @brief number of identities inserted in the Bloom filter
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_MEMBERSHIP_H_
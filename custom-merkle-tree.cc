@@ -0,0 +1,137 @@
+// custom-merkle-tree.cpp
+
+#include "custom-merkle-tree.hpp"
+#include "custom-schema-tlv.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/block-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ns3/ndnSIM/ndn-cxx/signature.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/sha256.hpp"
+
+// system libs
+#include <algorithm>
+#include <stdexcept> // for standard exception classes
+
+namespace ns3 {
+  namespace ndn {
+
+    namespace {
+
+      // domain separation of leaves and inner nodes
+      const uint8_t LEAF_PREFIX = 0x00;
+      const uint8_t NODE_PREFIX = 0x01;
+
+    } // namespace
+
+    CustomMerkleTree::CustomMerkleTree(std::vector<::ndn::ConstBufferPtr> leaves) : m_size(leaves.size()) {
+      if(leaves.empty()) {
+        throw std::runtime_error("Cannot build a Merkle tree without leaves");
+      }
+      size_t padded = 1;
+      while(padded < leaves.size()) {
+        padded *= 2;
+      }
+      leaves.resize(padded, leaves.back());
+
+      m_levels.push_back(std::move(leaves));
+      while(m_levels.back().size() > 1) {
+        const auto &level = m_levels.back();
+        std::vector<::ndn::ConstBufferPtr> parents;
+        for(size_t i = 0; i < level.size(); i += 2) {
+          parents.push_back(hashNode(*level[i], *level[i + 1]));
+        }
+        m_levels.push_back(std::move(parents));
+      }
+    }
+
+    ::ndn::ConstBufferPtr CustomMerkleTree::getRoot() const { return m_levels.back().front(); }
+
+    size_t CustomMerkleTree::size() const { return m_size; }
+
+    std::vector<::ndn::ConstBufferPtr> CustomMerkleTree::getProof(size_t index) const {
+      if(index >= m_size) {
+        throw std::out_of_range("Merkle leaf " + std::to_string(index) + " out of range");
+      }
+      std::vector<::ndn::ConstBufferPtr> proof;
+      for(size_t level = 0; level + 1 < m_levels.size(); level++) {
+        proof.push_back(m_levels[level][index ^ 1]);
+        index /= 2;
+      }
+      return proof;
+    }
+
+    ::ndn::ConstBufferPtr CustomMerkleTree::hashLeaf(const uint8_t *buf, size_t size) {
+      ::ndn::util::Sha256 sha256;
+      sha256.update(&LEAF_PREFIX, 1);
+      sha256.update(buf, size);
+      return sha256.computeDigest();
+    }
+
+    ::ndn::ConstBufferPtr CustomMerkleTree::hashNode(const ::ndn::Buffer &left, const ::ndn::Buffer &right) {
+      ::ndn::util::Sha256 sha256;
+      sha256.update(&NODE_PREFIX, 1);
+      sha256.update(left.data(), left.size());
+      sha256.update(right.data(), right.size());
+      return sha256.computeDigest();
+    }
+
+    ::ndn::ConstBufferPtr CustomMerkleTree::computeRoot(::ndn::ConstBufferPtr leaf, size_t index,
+                                                       const std::vector<::ndn::ConstBufferPtr> &proof) {
+      auto digest = leaf;
+      for(const auto &sibling : proof) {
+        digest = (index % 2 == 0 ? hashNode(*digest, *sibling) : hashNode(*sibling, *digest));
+        index /= 2;
+      }
+      return digest;
+    }
+
+    void CustomMerkleTree::prepareData(::ndn::Data &data, const ::ndn::Name &rootName) {
+      ::ndn::SignatureInfo sigInfo(static_cast<::ndn::tlv::SignatureTypeValue>(SignatureMerkleSha256),
+                                   ::ndn::KeyLocator(rootName));
+      data.setSignature(::ndn::Signature(sigInfo));
+    }
+
+    ::ndn::ConstBufferPtr CustomMerkleTree::hashData(const ::ndn::Data &data) {
+      ::ndn::EncodingBuffer encoder;
+      data.wireEncode(encoder, true); // signed portion only
+      return hashLeaf(encoder.buf(), encoder.size());
+    }
+
+    void CustomMerkleTree::setProof(::ndn::Data &data, size_t index,
+                                    const std::vector<::ndn::ConstBufferPtr> &proof) {
+      ::ndn::Block value(::ndn::tlv::SignatureValue);
+      value.push_back(::ndn::encoding::makeNonNegativeIntegerBlock(CustomSchemaTlv::LeafIndex, index));
+      for(const auto &digest : proof) {
+        value.push_back(::ndn::encoding::makeBinaryBlock(CustomSchemaTlv::ProofDigest, digest->data(),
+                                                         digest->size()));
+      }
+      value.encode();
+      data.setSignatureValue(value);
+    }
+
+    bool CustomMerkleTree::verifyData(const ::ndn::Data &data, const ::ndn::Buffer &root) {
+      if(data.getSignature().getType() != SignatureMerkleSha256) {
+        return false;
+      }
+      try {
+        auto value = data.getSignature().getValue();
+        value.parse();
+        size_t index = 0;
+        std::vector<::ndn::ConstBufferPtr> proof;
+        for(const auto &element : value.elements()) {
+          if(element.type() == CustomSchemaTlv::LeafIndex) {
+            index = ::ndn::encoding::readNonNegativeInteger(element);
+          } else if(element.type() == CustomSchemaTlv::ProofDigest) {
+            proof.push_back(std::make_shared<::ndn::Buffer>(element.value(), element.value_size()));
+          }
+        }
+        auto digest = computeRoot(hashData(data), index, proof);
+        return (digest->size() == root.size() && std::equal(digest->begin(), digest->end(), root.begin()));
+      } catch(const ::ndn::tlv::Error &e) {
+        return false;
+      }
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,62 @@
+// custom-merkle-tree.hpp
+
+#ifndef CUSTOM_MERKLE_TREE_H_
+#define CUSTOM_MERKLE_TREE_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/data.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/buffer.hpp"
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+
+// system libs
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief SHA-256 Merkle tree over a batch of Data packets, signed once through its root.
+     *
+     * Every Data of the batch carries SignatureType SignatureMerkleSha256, a KeyLocator with the name of
+     * the root Data (root digest as content, signed by the producer KEY) and its inclusion proof (leaf
+     * index and sibling digests) as SignatureValue. Leaves cover the signed portion of the Data, so the
+     * proof does not depend on itself. The leaf count is padded to a power of two with the last leaf.
+     *
+     * Only depends on ndn-cxx, so it can be reused outside of ns-3.
+     */
+    class CustomMerkleTree {
+    public:
+      enum : uint32_t { SignatureMerkleSha256 = 200 };
+
+    public:
+      explicit CustomMerkleTree(std::vector<::ndn::ConstBufferPtr> leaves);
+
+      ::ndn::ConstBufferPtr getRoot() const;
+      size_t size() const;
+
+      /// @brief sibling digests from the leaf up to the root
+      std::vector<::ndn::ConstBufferPtr> getProof(size_t index) const;
+
+      static ::ndn::ConstBufferPtr hashLeaf(const uint8_t *buf, size_t size);
+      static ::ndn::ConstBufferPtr hashNode(const ::ndn::Buffer &left, const ::ndn::Buffer &right);
+      static ::ndn::ConstBufferPtr computeRoot(::ndn::ConstBufferPtr leaf, size_t index,
+                                               const std::vector<::ndn::ConstBufferPtr> &proof);
+
+      /// @brief set the batch SignatureInfo (must be done before hashData)
+      static void prepareData(::ndn::Data &data, const ::ndn::Name &rootName);
+      /// @brief leaf digest of the signed portion of the Data
+      static ::ndn::ConstBufferPtr hashData(const ::ndn::Data &data);
+      static void setProof(::ndn::Data &data, size_t index, const std::vector<::ndn::ConstBufferPtr> &proof);
+      /// @brief true if the inclusion proof of the Data leads to the root
+      static bool verifyData(const ::ndn::Data &data, const ::ndn::Buffer &root);
+
+    private:
+      std::vector<std::vector<::ndn::ConstBufferPtr>> m_levels; ///< @brief leaves first, root last
+      size_t m_size;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_MERKLE_TREE_H_
@@ -1,12 +1,15 @@
 // custom-producer.cpp
 
 #include "custom-producer.hpp"
+#include "custom-merkle-tree.hpp"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
@@ -16,6 +19,7 @@
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
@@ -46,11 +50,31 @@ namespace ns3 {
                             TimeValue(Seconds(0)), MakeTimeAccessor(&CustomProducer::m_freshness),
                             MakeTimeChecker())
               .AddAttribute("IdentityPrefix", "Name of the Identity of the App", StringValue(""),
-                            MakeNameAccessor(&CustomProducer::m_identityPrefix), MakeNameChecker());
+                            MakeNameAccessor(&CustomProducer::m_identityPrefix), MakeNameChecker())
+              .AddAttribute("AttachCertificate", "Bundle the (signed) certificate with content Data packets",
+                            BooleanValue(false), MakeBooleanAccessor(&CustomProducer::m_attachCertificate),
+                            MakeBooleanChecker())
+              .AddAttribute("BatchSize", "Content Data signed together as a Merkle batch (1 = no batching)",
+                            UintegerValue(1), MakeUintegerAccessor(&CustomProducer::m_batchSize),
+                            MakeUintegerChecker<uint32_t>(1))
+              .AddAttribute("BatchTimeout", "Max time a content Data waits for its batch to fill",
+                            TimeValue(MilliSeconds(10)), MakeTimeAccessor(&CustomProducer::m_batchTimeout),
+                            MakeTimeChecker())
+              .AddAttribute("SignStartJitter", "Max random delay of the first SIGN (also added to retries)",
+                            TimeValue(MilliSeconds(100)),
+                            MakeTimeAccessor(&CustomProducer::m_signStartJitter), MakeTimeChecker())
+              .AddAttribute("SignBackoffMax", "Cap of the exponential backoff between SIGN retries",
+                            TimeValue(Seconds(16.0)), MakeTimeAccessor(&CustomProducer::m_signBackoffMax),
+                            MakeTimeChecker())
+              .AddTraceSource("SignRetries", "SIGN Interest retry scheduled (retry number, backoff delay)",
+                              MakeTraceSourceAccessor(&CustomProducer::m_signRetriesTrace),
+                              "ns3::ndn::CustomProducer::SignRetriesCallback");
       return tid;
     }
 
-    CustomProducer::CustomProducer() : CustomApp() {}
+    CustomProducer::CustomProducer()
+        : CustomApp(), m_attachCertificate(false), m_batchSize(1), m_signRetries(0), m_signNacked(false),
+          m_signCompleted(false), m_signJitter(CreateObject<UniformRandomVariable>()), m_batchSeq(0) {}
     CustomProducer::~CustomProducer() {}
 
     void CustomProducer::StartApplication() {
@@ -59,26 +83,32 @@ namespace ns3 {
 
       // equivalent to setting interest filter for "/prefix" prefix
       ndn::FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+      m_batchPrefix = m_prefix.deepCopy().append("BATCH");
 
       // create self-signed certificate/identity and serve it
       m_identityPrefix = (m_identityPrefix == "" ? m_prefix.deepCopy() : m_identityPrefix);
-      auto &cert = createCertificate(m_identityPrefix);
+      // (the zone group key is encrypted to the producer KEY, which requires RSA)
+      auto &cert = (m_useGroupKey ? createCertificate(m_identityPrefix, ::ndn::RsaKeyParams())
+                                  : createCertificate(m_identityPrefix));
       ndn::FibHelper::AddRoute(GetNode(), ::ndn::security::v2::extractKeyNameFromCertName(cert.getName()),
                                m_face, 0);
       NS_LOG_DEBUG("Serving Data prefix: " << m_prefix << " - Certificate: " << cert.getName());
+      // warm start: certificate already signed by the zone (restored from a snapshot)
+      m_signCompleted = (cert.getIssuerId() != ::ndn::name::Component("self"));
 
       // enable packet validation
       // --> ASSUMPTION 01: trust anchor .CERT out-of-band distribution
       setShouldValidateData(true);
 
+      m_signBackoff = std::min(m_signLifetime, m_signBackoffMax);
       scheduleSignInterest();    ///< @brief request for certificate signing
+      if(m_signCompleted && m_useGroupKey) {
+        requestGroupKey();
+      }
       scheduleSubscribeSchema(); ///< @brief subcribe for SCHEMA updates
 
       // request current trust schema
-      InterestOptions opts;
-      opts.canBePrefix = false;
-      opts.mustBeFresh = true;
-      sendInterest(m_schemaContentPrefix, m_schemaSubscribeLifetime, opts);
+      requestValidationRules();
 
       printKeyChain();
     }
@@ -92,7 +122,7 @@ namespace ns3 {
       CustomApp::OnInterestKey(interest);
       NS_LOG_FUNCTION(interest->getName());
 
-      // disable caching for certificates
+      // certificates keep the freshness set by the issuer (cached while valid)
       DataOptions opts;
       sendCertificate(interest, opts);
     }
@@ -109,25 +139,57 @@ namespace ns3 {
         return;
       }
 
+      if(m_batchPrefix.isPrefixOf(dataName)) {
+        // Merkle root of a batch signed by this producer
+        for(const auto &root : m_batchRoots) {
+          if(root->getName() == dataName) {
+            sendData(root);
+            return;
+          }
+        }
+        NS_LOG_INFO("Dropping interest '" << dataName << "' - unknown BATCH root");
+        return;
+      }
+
       auto data = make_shared<Data>();
       data->setName(dataName);
       data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
       data->setContent(make_shared<::ndn::Buffer>(m_virtualPayloadSize));
 
-      // Sign Data packet with default identity
-      m_keyChain.sign(*data, m_signingInfo);
+      if(m_groupKey != nullptr) {
+        // zone group key: one HMAC instead of an asymmetric signature
+        auto start = std::chrono::steady_clock::now();
+        CustomGroupKey::signData(*data, m_groupKeyName, *m_groupKey);
+        traceCryptoTime(start);
+        chargeCpu(CustomCpuModel::SIGN, ::ndn::tlv::SignatureHmacWithSha256);
+        sendData(data);
+        return;
+      }
 
-      // send packet
-      sendData(data);
+      if(m_batchSize > 1) {
+        // signed later, together with the next content Data
+        m_batch.push_back(data);
+        if(m_batch.size() >= m_batchSize) {
+          signBatch();
+        } else if(m_batch.size() == 1) {
+          m_batchTimer = Simulator::Schedule(m_batchTimeout, &CustomProducer::signBatch, this);
+        }
+        return;
+      }
+      attachProducerCertificate(*data);
+
+      // Sign Data packet with default identity (on the crypto pool), send packet
+      signAsync(data, m_signingInfo, [this, data] { sendData(data); });
     }
 
-    void CustomProducer::OnDataCertificate(std::shared_ptr<const ndn::Data> data) {
+    void CustomProducer::OnDataCertificate(std::shared_ptr<const ndn::Data> data,
+                                           const ValidationContext &ctx) {
       NS_LOG_FUNCTION(data->getName());
-      CustomApp::OnDataCertificate(data);
+      CustomApp::OnDataCertificate(data, ctx);
 
       NS_LOG_INFO("Received CERTIFICATE for '" << data->getName() << "'");
       if(m_signPrefix.isPrefixOf(data->getName())) {
-        if(!isDataValid()) {
+        if(!ctx.validated) {
           // received the signed certificate from trust anchor, but we need
           // to validate it
           NS_LOG_INFO("Validating SIGN packet ...");
@@ -135,31 +197,47 @@ namespace ns3 {
           CustomApp::OnData(data);
         } else {
           NS_LOG_INFO("Opening CERTIFICATE payload of  '" << data->getName() << "' ...");
+          stopSignInterest();
           auto certPtr =
               std::make_shared<::ndn::security::v2::Certificate>(data->getContent().blockFromValue());
-          CustomProducer::OnDataCertificate(certPtr);
+          CustomProducer::OnDataCertificate(certPtr, ctx); // trusted through the validated SIGN Data
+          if(m_useGroupKey) {
+            requestGroupKey();
+          }
         }
-      } else if(m_identityPrefix.isPrefixOf(data->getName()) && isDataValid()) {
+      } else if(m_identityPrefix.isPrefixOf(data->getName()) && ctx.validated) {
         NS_LOG_INFO("Parsing CERTIFICATE '" << data->getName() << "' ...");
         ::ndn::security::v2::Certificate cert(*data);
         addCertificate(cert);
       }
     }
 
-    void CustomProducer::OnDataContent(std::shared_ptr<const ndn::Data> data) {
+    void CustomProducer::OnDataContent(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) {
       NS_LOG_FUNCTION(data->getName());
-      CustomApp::OnDataContent(data);
-
-      // onData(SCHEMA/CONTENT)
-      if(m_schemaContentPrefix.isPrefixOf(data->getName())) {
-        readValidationRules(data);
-        // onData(SCHEMA/SUBSCRIBE)
-      } else if(m_schemaSubscribePrefix.isPrefixOf(data->getName())) {
-        NS_LOG_INFO("Sending SCHEMA content Interest for '" << m_schemaContentPrefix << "' ... ");
-        InterestOptions opts;
-        opts.canBePrefix = false;
-        opts.mustBeFresh = true;
-        sendInterest(m_schemaContentPrefix, m_schemaSubscribeLifetime, opts);
+      CustomApp::OnDataContent(data, ctx);
+
+      if(m_groupKeyPrefix.isPrefixOf(data->getName())) {
+        if(ctx.validated) {
+          installGroupKey(*data);
+        }
+        return;
+      }
+
+      // onData(SCHEMA/CONTENT) or onData(SCHEMA/SUBSCRIBE)
+      OnDataSchema(data);
+    }
+
+    void CustomProducer::OnNack(std::shared_ptr<const ::ndn::lp::Nack> nack) {
+      CustomApp::OnNack(nack);
+      NS_LOG_FUNCTION(nack->getInterest().getName() << nack->getReason());
+
+      // trust anchor is saturated: back off right away instead of waiting for the SIGN timeout
+      if(m_signPrefix.isPrefixOf(nack->getInterest().getName()) &&
+         nack->getReason() == ::ndn::lp::NackReason::CONGESTION && !m_signCompleted) {
+        auto signPrefixStr = m_signPrefix.toUri();
+        Simulator::Cancel(m_sendEvents[signPrefixStr]);
+        m_signNacked = true;
+        scheduleSignInterest(); // current backoff, doubled only when a SIGN Interest times out
       }
     }
 
@@ -177,24 +255,132 @@ namespace ns3 {
     //     PRIVATE
     //////////////////////
 
+    /// @brief first SIGN after a random jitter, then retry with exponential backoff until signed
     void CustomProducer::scheduleSignInterest() {
       auto signPrefixStr = m_signPrefix.toUri();
-      if(!hasEvent(signPrefixStr)) {
-        m_sendEvents[signPrefixStr] =
-            Simulator::Schedule(Seconds(0.0), &CustomProducer::sendSignInterest, this);
+      auto jitter = Seconds(m_signJitter->GetValue(0.0, m_signStartJitter.GetSeconds()));
+      if(m_signCompleted) {
+        return;
+      } else if(!hasEvent(signPrefixStr)) {
+        // spread the start of the producers, so they do not hit the trust anchor at once
+        m_sendEvents[signPrefixStr] = Simulator::Schedule(jitter, &CustomProducer::sendSignInterest, this);
       } else if(!isEventRunning(signPrefixStr)) {
-        m_sendEvents[signPrefixStr] =
-            Simulator::Schedule(m_signLifetime, &CustomProducer::sendSignInterest, this);
+        // wait for the SIGN Interest to time out: SignLifetime * 2^(timeouts), capped
+        auto delay = m_signBackoff + jitter;
+        m_signRetriesTrace(this, m_signRetries, delay);
+        m_sendEvents[signPrefixStr] = Simulator::Schedule(delay, &CustomProducer::sendSignInterest, this);
+      }
+    }
+
+    /// @brief consumers validate the Data without fetching the certificate first
+    void CustomProducer::attachProducerCertificate(ndn::Data &data) {
+      if(m_attachCertificate && m_signCompleted) {
+        std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
+        auto key = m_keyChain.getPib().getIdentity(m_identityPrefix).getDefaultKey();
+        attachCertificate(data, key.getDefaultCertificate());
       }
     }
 
+    /// @brief sign the pending content Data with one signature over their Merkle root, then send them
+    ///        with their inclusion proofs (the root is served under /<prefix>/BATCH/<node>/<seq>)
+    void CustomProducer::signBatch() {
+      Simulator::Cancel(m_batchTimer);
+      if(m_batch.empty()) {
+        return;
+      }
+      auto batch = std::move(m_batch);
+      m_batch.clear();
+
+      auto rootName = m_batchPrefix.deepCopy().append(std::to_string(GetNode()->GetId()));
+      rootName.appendNumber(m_batchSeq++);
+      std::vector<::ndn::ConstBufferPtr> leaves;
+      for(auto &data : batch) {
+        CustomMerkleTree::prepareData(*data, rootName);
+        leaves.push_back(CustomMerkleTree::hashData(*data));
+        chargeCpu(CustomCpuModel::SIGN, ::ndn::tlv::DigestSha256);
+      }
+      auto tree = std::make_shared<CustomMerkleTree>(leaves);
+      NS_LOG_DEBUG("Signing BATCH '" << rootName << "' of " << batch.size() << " Data");
+
+      auto root = make_shared<Data>(rootName);
+      root->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+      root->setContent(tree->getRoot()->data(), tree->getRoot()->size());
+      attachProducerCertificate(*root);
+
+      signAsync(root, m_signingInfo, [this, batch, tree, root] {
+        m_batchRoots.push_back(root);
+        if(m_batchRoots.size() > MAX_BATCH_ROOTS) {
+          m_batchRoots.pop_front();
+        }
+        for(size_t i = 0; i < batch.size(); i++) {
+          CustomMerkleTree::setProof(*batch[i], i, tree->getProof(i));
+          sendData(batch[i]);
+        }
+      });
+    }
+
+    /// @brief fetch the zone group key (encrypted to the producer KEY), retried until received
+    void CustomProducer::requestGroupKey() {
+      if(m_groupKey != nullptr) {
+        return;
+      }
+      std::unique_lock<std::recursive_mutex> lock(m_keyChainMutex);
+      auto keyName = m_keyChain.getPib().getDefaultIdentity().getDefaultKey().getName();
+      lock.unlock();
+      InterestOptions opts;
+      opts.mustBeFresh = true;
+      sendInterest(m_groupKeyPrefix.deepCopy().append(keyName), m_signLifetime, opts);
+      m_sendEvents[m_groupKeyPrefix.toUri()] =
+          Simulator::Schedule(m_signLifetime, &CustomProducer::requestGroupKey, this);
+    }
+
+    /// @brief decrypt the zone group key with the producer KEY, content Data are then signed with it
+    void CustomProducer::installGroupKey(const ndn::Data &data) {
+      auto keyName = data.getName().getSubName(m_groupKeyPrefix.size());
+      try {
+        auto groupKey = CustomGroupKey::decodeKey(data.getContent().blockFromValue());
+        auto &encryptedKey = groupKey.second;
+        std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
+        auto key = m_keyChain.getTpm().decrypt(encryptedKey.value(), encryptedKey.value_size(), keyName);
+        if(key == nullptr) {
+          throw std::runtime_error("no private KEY '" + keyName.toUri() + "'");
+        }
+        m_groupKeyName = groupKey.first;
+        m_groupKey = key;
+      } catch(const std::exception &e) {
+        NS_LOG_WARN("Failed to install group KEY of '" << data.getName() << "' - Error=" << e.what());
+        return;
+      }
+      Simulator::Cancel(m_sendEvents[m_groupKeyPrefix.toUri()]);
+      NS_LOG_INFO("Signing content with group KEY '" << m_groupKeyName << "'");
+    }
+
     void CustomProducer::sendSignInterest() {
+      std::unique_lock<std::recursive_mutex> lock(m_keyChainMutex);
       auto keyName = m_keyChain.getPib().getDefaultIdentity().getDefaultKey().getName();
+      lock.unlock();
       ::ndn::Name producerKeySignPrefix = m_signPrefix.deepCopy().append(keyName);
+      if(m_signRetries > 0 && !m_signNacked) {
+        // previous SIGN Interest timed out
+        m_signBackoff = std::min(m_signBackoff + m_signBackoff, m_signBackoffMax);
+      }
+      m_signNacked = false;
       InterestOptions opts;
       opts.canBePrefix = true;
       opts.mustBeFresh = true;
       sendInterest(producerKeySignPrefix, m_signLifetime, opts);
+      m_signRetries++;
+      scheduleSignInterest();
+    }
+
+    void CustomProducer::stopSignInterest() {
+      auto signPrefixStr = m_signPrefix.toUri();
+      NS_LOG_INFO("SIGN completed after " << m_signRetries << " Interests");
+      m_signCompleted = true;
+      logEvent(CustomEventLog::ENROLLED, m_signRetries);
+      if(hasEvent(signPrefixStr)) {
+        Simulator::Cancel(m_sendEvents[signPrefixStr]);
+      }
     }
 
   } // namespace ndn
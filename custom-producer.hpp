@@ -6,16 +6,20 @@
 #include "ns3/attribute-helper.h"
 #include "ns3/attribute.h"
 #include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
+#include "ns3/traced-callback.h"
 
 #include "ns3/ndnSIM/apps/ndn-producer.hpp"
 
 #include "ns3/ndnSIM/ndn-cxx/security/key-chain.hpp"
 #include "ns3/ndnSIM/ndn-cxx/security/signing-helpers.hpp"
 
+#include <deque>
 #include <functional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "custom-app.hpp"
 
@@ -24,6 +28,10 @@ namespace ns3 {
 
     class CustomProducer : public CustomApp {
 
+    public:
+      /// @brief SIGN retry scheduled (producer app, retry number, backoff delay)
+      typedef void (*SignRetriesCallback)(Ptr<App> app, uint32_t retries, Time delay);
+
     public:
       static TypeId GetTypeId();
       CustomProducer();
@@ -35,8 +43,10 @@ namespace ns3 {
       void OnInterestKey(std::shared_ptr<const ndn::Interest> interest) override;
       void OnInterestContent(std::shared_ptr<const ndn::Interest> interest) override;
 
-      void OnDataCertificate(std::shared_ptr<const ndn::Data> data) override;
-      void OnDataContent(std::shared_ptr<const ndn::Data> data) override;
+      void OnDataCertificate(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) override;
+      void OnDataContent(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) override;
+
+      void OnNack(std::shared_ptr<const ::ndn::lp::Nack> nack) override;
 
       // void OnDataValidationFailed(const ndn::Data &data,
       //                             const ::ndn::security::v2::ValidationError &error) override;
@@ -46,10 +56,37 @@ namespace ns3 {
       uint32_t m_virtualPayloadSize;
       Time m_freshness;
       ::ndn::Name m_identityPrefix;
+      bool m_attachCertificate; ///< @brief bundle the signed certificate with content Data
+      uint32_t m_batchSize;     ///< @brief content Data signed per Merkle batch (1 = one signature per Data)
+      Time m_batchTimeout;      ///< @brief max time a content Data waits for its batch to fill
 
     private:
       void scheduleSignInterest();
       void sendSignInterest();
+      void stopSignInterest();
+
+      void attachProducerCertificate(ndn::Data &data);
+      void signBatch();
+
+      void requestGroupKey();
+      void installGroupKey(const ndn::Data &data);
+
+    private:
+      Time m_signStartJitter; ///< @brief max random delay before the first SIGN (and added to each retry)
+      Time m_signBackoffMax;  ///< @brief cap of the exponential SIGN retry backoff
+      uint32_t m_signRetries; ///< @brief SIGN Interests sent without a signed certificate back
+      Time m_signBackoff;     ///< @brief delay before the next SIGN retry (doubles up to SignBackoffMax)
+      bool m_signNacked;      ///< @brief pending SIGN retry was rescheduled by a Nack (no timeout)
+      bool m_signCompleted;
+      Ptr<UniformRandomVariable> m_signJitter;
+
+      ::ndn::Name m_batchPrefix;                          ///< @brief /<prefix>/BATCH (Merkle root Data)
+      std::vector<std::shared_ptr<ndn::Data>> m_batch;    ///< @brief content Data waiting to be signed
+      EventId m_batchTimer;                               ///< @brief signs a partial batch on BatchTimeout
+      uint64_t m_batchSeq;                                ///< @brief sequence number of the next batch
+      std::deque<std::shared_ptr<ndn::Data>> m_batchRoots; ///< @brief recent signed roots, served on request
+
+      TracedCallback<Ptr<App>, uint32_t, Time> m_signRetriesTrace;
     };
 
   } // namespace ndn
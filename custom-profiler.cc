@@ -0,0 +1,65 @@
+// custom-profiler.cpp
+
+#include "custom-profiler.hpp"
+
+// system libs
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    CustomProfiler::Scope::Scope(const char *name)
+        : m_name(name), m_start(std::chrono::steady_clock::now()) {}
+
+    CustomProfiler::Scope::~Scope() {
+      CustomProfiler::getInstance().add(m_name, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                    std::chrono::steady_clock::now() - m_start));
+    }
+
+    CustomProfiler &CustomProfiler::getInstance() {
+      static CustomProfiler instance;
+      return instance;
+    }
+
+    void CustomProfiler::add(const std::string &name, std::chrono::nanoseconds elapsed) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto &stats = m_stats[name];
+      stats.count++;
+      stats.total += elapsed;
+      stats.max = std::max(stats.max, elapsed);
+    }
+
+    std::map<std::string, CustomProfiler::Stats> CustomProfiler::getStats() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_stats;
+    }
+
+    void CustomProfiler::clear() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stats.clear();
+    }
+
+    void CustomProfiler::dump(std::ostream &os) {
+      auto stats = getStats();
+      std::vector<std::pair<std::string, Stats>> sorted(stats.begin(), stats.end());
+      std::sort(sorted.begin(), sorted.end(),
+                [](const std::pair<std::string, Stats> &a, const std::pair<std::string, Stats> &b) {
+                  return a.second.total > b.second.total;
+                });
+      os << "Scope\tCalls\tTotal(s)\tMean(ms)\tMax(ms)\n";
+      for(const auto &pairNameStats : sorted) {
+        const auto &s = pairNameStats.second;
+        os << pairNameStats.first << "\t" << s.count << "\t" << s.total.count() / 1e9 << "\t"
+           << s.total.count() / 1e6 / s.count << "\t" << s.max.count() / 1e6 << "\n";
+      }
+    }
+
+    void CustomProfiler::dumpToFile(const std::string &filename) {
+      std::ofstream os(filename);
+      getInstance().dump(os);
+    }
+
+  } // namespace ndn
+} // namespace ns3
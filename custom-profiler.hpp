@@ -0,0 +1,78 @@
+// custom-profiler.hpp
+
+#ifndef CUSTOM_PROFILER_H_
+#define CUSTOM_PROFILER_H_
+
+// system libs
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+
+/**
+ * @brief Wall-clock timer of the enclosing scope, aggregated by name in CustomProfiler.
+ *
+ * Only compiled in with -DCUSTOM_PROFILE (e.g. CXXFLAGS="-DCUSTOM_PROFILE" ./waf configure), otherwise it
+ * expands to nothing.
+ */
+#ifdef CUSTOM_PROFILE
+#define CUSTOM_PROFILE_CONCAT_(a, b) a##b
+#define CUSTOM_PROFILE_CONCAT(a, b) CUSTOM_PROFILE_CONCAT_(a, b)
+#define CUSTOM_PROFILE_SCOPE(name)                                                                           \
+  ::ns3::ndn::CustomProfiler::Scope CUSTOM_PROFILE_CONCAT(customProfileScope, __LINE__)(name)
+#else
+#define CUSTOM_PROFILE_SCOPE(name)
+#endif
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Process-wide wall-clock profile (call count, total and max time per scope name).
+     *
+     * Scopes may run on any thread (e.g. CustomSchemaStore writer).
+     */
+    class CustomProfiler {
+    public:
+      struct Stats {
+        uint64_t count = 0;
+        std::chrono::nanoseconds total{0};
+        std::chrono::nanoseconds max{0};
+      };
+
+      /// @brief times its own lifetime
+      class Scope {
+      public:
+        explicit Scope(const char *name);
+        ~Scope();
+
+      private:
+        const char *m_name;
+        std::chrono::steady_clock::time_point m_start;
+      };
+
+    public:
+      static CustomProfiler &getInstance();
+
+      void add(const std::string &name, std::chrono::nanoseconds elapsed);
+      std::map<std::string, Stats> getStats();
+      void clear();
+
+      /// @brief tab-separated table, most expensive scopes first
+      void dump(std::ostream &os);
+      static void dumpToFile(const std::string &filename);
+
+    private:
+      CustomProfiler() = default;
+
+    private:
+      std::mutex m_mutex;
+      std::map<std::string, Stats> m_stats;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_PROFILER_H_
@@ -0,0 +1,362 @@
+// custom-rule-index.cpp
+
+#include "custom-rule-index.hpp"
+#include "custom-group-key.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/security/security-common.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/certificate.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/certificate-request.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validation-state.hpp"
+#include "ns3/ndnSIM/ndn-cxx/signature-info.hpp"
+
+// system libs
+#include <algorithm>
+#include <stdexcept> // for standard exception classes
+
+namespace ns3 {
+  namespace ndn {
+
+    //////////////////////
+    //  CustomRuleIndex
+    //////////////////////
+
+    CustomRuleIndex::CustomRuleIndex() : m_owner(std::this_thread::get_id()) {}
+
+    void CustomRuleIndex::load(const ::ndn::security::v2::validator_config::ConfigSection &schema) {
+      clear();
+      m_owner = std::this_thread::get_id();
+      for(const auto &item : schema) {
+        if(item.first == "rule") {
+          addRule(item.second);
+        } else if(item.first == "membership") {
+          // one membership section per zone (schemas of trusted zones are merged)
+          m_memberships.push_back(CustomMembershipSet::fromConfigSection(item.second));
+        }
+      }
+      // enrolled checkers only accept the members of the zone of their rule (longest zone prefix)
+      for(auto &rule : m_rules) {
+        for(auto &checker : rule.checkers) {
+          checker.membership = std::string::npos;
+          size_t zoneSize = 0;
+          for(size_t i = 0; i < m_memberships.size() && checker.enrolledOnly; i++) {
+            auto &zone = m_memberships[i].getZone();
+            if(zone.isPrefixOf(rule.prefix) &&
+               (checker.membership == std::string::npos || zone.size() > zoneSize)) {
+              checker.membership = i;
+              zoneSize = zone.size();
+            }
+          }
+        }
+      }
+    }
+
+    void CustomRuleIndex::clear() {
+      m_rules.clear();
+      m_memberships.clear();
+      m_dataRoot.children.clear();
+      m_dataRoot.rules.clear();
+      m_interestRoot.children.clear();
+      m_interestRoot.rules.clear();
+    }
+
+    const CustomRuleIndex::Rule *CustomRuleIndex::findRule(const ::ndn::Name &name, bool isInterest) const {
+      checkThread();
+      // collect candidate rules along the name path
+      std::vector<size_t> candidates;
+      const TrieNode *node = (isInterest ? &m_interestRoot : &m_dataRoot);
+      candidates.insert(candidates.end(), node->rules.begin(), node->rules.end());
+      for(const auto &component : name) {
+        auto it = node->children.find(component);
+        if(it == node->children.end()) {
+          break;
+        }
+        node = it->second.get();
+        candidates.insert(candidates.end(), node->rules.begin(), node->rules.end());
+      }
+
+      // rule indexes follow schema order, so the first match is the smallest matching index
+      std::sort(candidates.begin(), candidates.end());
+      for(auto idx : candidates) {
+        if(m_rules[idx].filterRegex->match(name)) {
+          return &m_rules[idx];
+        }
+      }
+      return nullptr;
+    }
+
+    bool CustomRuleIndex::checkKeyLocator(const Checker &checker, const ::ndn::Name &name,
+                                          const ::ndn::Name &klName) const {
+      checkThread();
+      if(checker.keyLocatorRegex != nullptr && !checker.keyLocatorRegex->match(klName)) {
+        return false;
+      }
+      if(checker.hyperRelation != nullptr) {
+        auto &hyper = *checker.hyperRelation;
+        if(!hyper.kRegex->match(klName) || !hyper.pRegex->match(name)) {
+          return false;
+        }
+        auto kName = hyper.kRegex->expand(hyper.kExpand);
+        auto pName = hyper.pRegex->expand(hyper.pExpand);
+        if(hyper.relation == "equal") {
+          if(kName != pName) {
+            return false;
+          }
+        } else if(hyper.relation == "is-prefix-of") {
+          if(!kName.isPrefixOf(pName)) {
+            return false;
+          }
+        } else if(!kName.isPrefixOf(pName) || kName.size() == pName.size()) { // is-strict-prefix-of
+          return false;
+        }
+      }
+      if(checker.enrolledOnly) {
+        // signer identity = KeyLocator name up to its last KEY component
+        for(ssize_t i = klName.size() - 1; i >= 0; i--) {
+          if(klName[i] == ::ndn::security::v2::Certificate::KEY_COMPONENT) {
+            return (checker.membership != std::string::npos &&
+                    m_memberships[checker.membership].contains(klName.getPrefix(i)));
+          }
+        }
+        return false;
+      }
+      return true;
+    }
+
+    size_t CustomRuleIndex::size() const { return m_rules.size(); }
+
+    const std::vector<CustomMembershipSet> &CustomRuleIndex::getMemberships() const { return m_memberships; }
+
+    ::ndn::Name CustomRuleIndex::extractLiteralPrefix(const std::string &regex) {
+      ::ndn::Name prefix;
+      // non-anchored regexes may match anywhere in the name
+      if(regex.empty() || regex[0] != '^') {
+        return prefix;
+      }
+      size_t pos = 1;
+      while(pos < regex.size() && regex[pos] == '<') {
+        size_t end = regex.find('>', pos);
+        if(end == std::string::npos) {
+          break;
+        }
+        std::string component = regex.substr(pos + 1, end - pos - 1);
+        // stop on wildcards, component regexes and repeated components
+        if(component.empty() || component.find_first_of(".[]()*+?{}|^$\\") != std::string::npos) {
+          break;
+        }
+        if(end + 1 < regex.size() && std::string("*+?{").find(regex[end + 1]) != std::string::npos) {
+          break;
+        }
+        prefix.append(::ndn::name::Component::fromEscapedString(component));
+        pos = end + 1;
+      }
+      return prefix;
+    }
+
+    /// @brief the regex matchers are stateful, see class description
+    void CustomRuleIndex::checkThread() const {
+      if(std::this_thread::get_id() != m_owner) {
+        throw std::logic_error("CustomRuleIndex used outside of the thread that loaded it");
+      }
+    }
+
+    void CustomRuleIndex::addRule(const ::ndn::security::v2::validator_config::ConfigSection &ruleSection) {
+      Rule rule;
+      rule.id = ruleSection.get<std::string>("id", "");
+      rule.order = m_rules.size();
+
+      auto pktType = ruleSection.get<std::string>("for", "data");
+      if(pktType != "data" && pktType != "interest") {
+        throw std::runtime_error("Rule '" + rule.id + "' - unsupported packet type '" + pktType + "'");
+      }
+
+      auto filterType = ruleSection.get<std::string>("filter.type", "name");
+      if(filterType != "name") {
+        throw std::runtime_error("Rule '" + rule.id + "' - unsupported filter type '" + filterType + "'");
+      }
+      auto filterRegex = ruleSection.get<std::string>("filter.regex");
+      rule.filterRegex = std::make_shared<::ndn::Regex>(filterRegex);
+
+      for(const auto &item : ruleSection) {
+        if(item.first == "checker") {
+          rule.checkers.push_back(parseChecker(item.second));
+        }
+      }
+      if(rule.checkers.empty()) {
+        throw std::runtime_error("Rule '" + rule.id + "' - no checker defined");
+      }
+      rule.prefix = extractLiteralPrefix(filterRegex);
+      m_rules.push_back(rule);
+
+      // store rule at the trie node of its literal prefix
+      TrieNode *node = (pktType == "interest" ? &m_interestRoot : &m_dataRoot);
+      for(const auto &component : rule.prefix) {
+        auto &child = node->children[component];
+        if(child == nullptr) {
+          child = std::make_unique<TrieNode>();
+        }
+        node = child.get();
+      }
+      node->rules.push_back(rule.order);
+    }
+
+    CustomRuleIndex::Checker CustomRuleIndex::parseChecker(
+        const ::ndn::security::v2::validator_config::ConfigSection &checkerSection) {
+      auto checkerType = checkerSection.get<std::string>("type", "customized");
+      if(checkerType != "customized") {
+        throw std::runtime_error("Unsupported checker type '" + checkerType + "'");
+      }
+
+      Checker checker;
+      checker.sigType = 0;
+      auto sigType = checkerSection.get<std::string>("sig-type", "");
+      if(sigType == "rsa-sha256") {
+        checker.sigType = ::ndn::tlv::SignatureSha256WithRsa;
+      } else if(sigType == "ecdsa-sha256") {
+        checker.sigType = ::ndn::tlv::SignatureSha256WithEcdsa;
+      } else if(sigType == "sha256") {
+        checker.sigType = ::ndn::tlv::DigestSha256;
+      } else if(sigType == "hmac-sha256") {
+        checker.sigType = ::ndn::tlv::SignatureHmacWithSha256;
+      } else if(sigType != "") {
+        throw std::runtime_error("Unsupported checker sig-type '" + sigType + "'");
+      }
+
+      auto klType = checkerSection.get<std::string>("key-locator.type", "name");
+      if(klType != "name") {
+        throw std::runtime_error("Unsupported key-locator type '" + klType + "'");
+      }
+      auto klRegex = checkerSection.get_optional<std::string>("key-locator.regex");
+      if(klRegex) {
+        checker.keyLocatorRegex = std::make_shared<::ndn::Regex>(*klRegex);
+      }
+      auto hyperSection = checkerSection.get_child_optional("key-locator.hyper-relation");
+      if(hyperSection) {
+        auto hyper = std::make_shared<HyperRelation>();
+        hyper->kRegex = std::make_shared<::ndn::Regex>(hyperSection->get<std::string>("k-regex"));
+        hyper->kExpand = hyperSection->get<std::string>("k-expand");
+        hyper->relation = hyperSection->get<std::string>("h-relation");
+        hyper->pRegex = std::make_shared<::ndn::Regex>(hyperSection->get<std::string>("p-regex"));
+        hyper->pExpand = hyperSection->get<std::string>("p-expand");
+        checker.hyperRelation = hyper;
+        auto &relation = hyper->relation;
+        if(relation != "equal" && relation != "is-prefix-of" && relation != "is-strict-prefix-of") {
+          throw std::runtime_error("Unsupported hyper-relation '" + relation + "'");
+        }
+      }
+      if(checker.keyLocatorRegex == nullptr && checker.hyperRelation == nullptr) {
+        throw std::runtime_error("Checker requires key-locator regex or hyper-relation");
+      }
+      checker.enrolledOnly = (checkerSection.get<std::string>("key-locator.enrolled", "false") == "true");
+      checker.membership = std::string::npos; // resolved once the whole schema is loaded
+      return checker;
+    }
+
+    //////////////////////
+    //  CustomValidationPolicy
+    //////////////////////
+
+    CustomValidationPolicy::CustomValidationPolicy()
+        : m_index(std::make_shared<CustomRuleIndex>()), m_shouldBypass(false) {}
+
+    void CustomValidationPolicy::setRuleIndex(std::shared_ptr<const CustomRuleIndex> index) {
+      m_index = index;
+    }
+    void CustomValidationPolicy::setBypass(bool bypass) { m_shouldBypass = bypass; }
+    void CustomValidationPolicy::setGroupKeyLookup(
+        std::function<::ndn::ConstBufferPtr(const ::ndn::Name &)> lookup) {
+      m_groupKeyLookup = lookup;
+    }
+
+    bool CustomValidationPolicy::isAllowed(const ::ndn::Data &data) const {
+      auto &signature = data.getSignature();
+      if(m_shouldBypass || signature.getType() == ::ndn::tlv::SignatureHmacWithSha256 ||
+         !signature.hasKeyLocator() || signature.getKeyLocator().getType() != ::ndn::tlv::Name) {
+        return false;
+      }
+      std::string error;
+      return (findChecker(data.getName(), false, signature.getType(), signature.getKeyLocator().getName(),
+                          error) != nullptr);
+    }
+
+    void CustomValidationPolicy::checkPolicy(
+        const ::ndn::Data &data, const std::shared_ptr<::ndn::security::v2::ValidationState> &state,
+        const ValidationContinuation &continueValidation) {
+      if(m_shouldBypass) {
+        return continueValidation(nullptr, state);
+      }
+      auto klName = ::ndn::security::v2::getKeyLocatorName(data, *state);
+      if(!state->getOutcome()) { // already failed
+        return;
+      }
+      checkRule(data.getName(), false, data.getSignature().getType(), klName, state, continueValidation,
+                &data);
+    }
+
+    void CustomValidationPolicy::checkPolicy(
+        const ::ndn::Interest &interest, const std::shared_ptr<::ndn::security::v2::ValidationState> &state,
+        const ValidationContinuation &continueValidation) {
+      if(m_shouldBypass) {
+        return continueValidation(nullptr, state);
+      }
+      auto klName = ::ndn::security::v2::getKeyLocatorName(interest, *state);
+      if(!state->getOutcome()) { // already failed
+        return;
+      }
+      ::ndn::SignatureInfo sigInfo(interest.getName()[::ndn::signed_interest::POS_SIG_INFO].blockFromValue());
+      checkRule(interest.getName(), true, sigInfo.getSignatureType(), klName, state, continueValidation);
+    }
+
+    void CustomValidationPolicy::checkRule(const ::ndn::Name &name, bool isInterest, uint32_t sigType,
+                                           const ::ndn::Name &klName,
+                                           const std::shared_ptr<::ndn::security::v2::ValidationState> &state,
+                                           const ValidationContinuation &continueValidation,
+                                           const ::ndn::Data *data) {
+      std::string error;
+      if(findChecker(name, isInterest, sigType, klName, error) == nullptr) {
+        return state->fail({::ndn::security::v2::ValidationError::POLICY_ERROR, error});
+      } else if(sigType == ::ndn::tlv::SignatureHmacWithSha256) {
+        return checkGroupKey(data, klName, state, continueValidation);
+      }
+      return continueValidation(
+          std::make_shared<::ndn::security::v2::CertificateRequest>(::ndn::Interest(klName)), state);
+    }
+
+    /// @brief first checker of the rule matching the name that accepts the KeyLocator name (nullptr = error)
+    const CustomRuleIndex::Checker *
+    CustomValidationPolicy::findChecker(const ::ndn::Name &name, bool isInterest, uint32_t sigType,
+                                        const ::ndn::Name &klName, std::string &error) const {
+      auto rule = m_index->findRule(name, isInterest);
+      if(rule == nullptr) {
+        error = "No rule matched for `" + name.toUri() + "`";
+        return nullptr;
+      }
+      for(const auto &checker : rule->checkers) {
+        if((checker.sigType == 0 || checker.sigType == sigType) &&
+           m_index->checkKeyLocator(checker, name, klName)) {
+          return &checker;
+        }
+      }
+      error = "KeyLocator `" + klName.toUri() + "` does not satisfy rule '" + rule->id + "'";
+      return nullptr;
+    }
+
+    /// @brief HMAC signed Data: checked here with the group key, there is no certificate to fetch
+    void CustomValidationPolicy::checkGroupKey(
+        const ::ndn::Data *data, const ::ndn::Name &klName,
+        const std::shared_ptr<::ndn::security::v2::ValidationState> &state,
+        const ValidationContinuation &continueValidation) {
+      auto key = (m_groupKeyLookup ? m_groupKeyLookup(klName) : nullptr);
+      if(data == nullptr || key == nullptr) {
+        return state->fail({::ndn::security::v2::ValidationError::INVALID_KEY_LOCATOR,
+                            "Unknown group key `" + klName.toUri() + "`"});
+      }
+      if(!CustomGroupKey::verifyData(*data, *key)) {
+        return state->fail({::ndn::security::v2::ValidationError::INVALID_SIGNATURE,
+                            "HMAC does not match group key `" + klName.toUri() + "`"});
+      }
+      return continueValidation(nullptr, state);
+    }
+
+  } // namespace ndn
+} // namespace ns3
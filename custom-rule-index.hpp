@@ -0,0 +1,152 @@
+// custom-rule-index.hpp
+
+#ifndef CUSTOM_RULE_INDEX_H_
+#define CUSTOM_RULE_INDEX_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validation-policy.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validator-config/common.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/regex.hpp"
+
+// system libs
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// custom includes
+#include "custom-membership.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Name-component trie over the trust schema rules.
+     *
+     * Every rule is stored at the trie node given by the literal prefix of its (anchored) filter regex,
+     * e.g. "^<zoneA><SIGN><>*$" is stored under /zoneA/SIGN. A lookup walks the trie along the packet
+     * name and only evaluates the regexes of the rules found on that path, keeping the first-match
+     * semantics of ValidatorConfig (rules are tried in the order they appear in the schema).
+     *
+     * Only depends on ndn-cxx, so it can be reused outside of ns-3.
+     *
+     * Not thread-safe: ::ndn::Regex keeps the state of its last match, so an index (shared by every
+     * validator that reads the same schema) may only be used by the thread that loaded it, which is
+     * enforced by findRule() and checkKeyLocator(). Only signature checks are run off that thread.
+     */
+    class CustomRuleIndex {
+    public:
+      /// @brief relation between the KeyLocator name and the packet name (with back-references)
+      struct HyperRelation {
+        std::shared_ptr<::ndn::Regex> kRegex;
+        std::string kExpand;
+        std::string relation; ///< @brief equal, is-prefix-of, is-strict-prefix-of
+        std::shared_ptr<::ndn::Regex> pRegex;
+        std::string pExpand;
+      };
+
+      struct Checker {
+        uint32_t sigType; ///< @brief required signature type (0 = any)
+        std::shared_ptr<::ndn::Regex> keyLocatorRegex;
+        std::shared_ptr<HyperRelation> hyperRelation;
+        bool enrolledOnly; ///< @brief signer identity must be in the zone membership set
+        size_t membership; ///< @brief membership set of the rule's zone (enrolledOnly, npos = none)
+      };
+
+      struct Rule {
+        std::string id;
+        size_t order; ///< @brief position of the rule in the schema
+        ::ndn::Name prefix; ///< @brief literal prefix of the filter regex
+        std::shared_ptr<::ndn::Regex> filterRegex;
+        std::vector<Checker> checkers;
+      };
+
+    public:
+      CustomRuleIndex();
+
+      /// @brief rebuild the index from the rules of a trust schema (trust anchors are ignored)
+      void load(const ::ndn::security::v2::validator_config::ConfigSection &schema);
+      void clear();
+
+      /// @brief first rule (in schema order) whose filter matches the name, nullptr if none does
+      const Rule *findRule(const ::ndn::Name &name, bool isInterest = false) const;
+
+      /// @brief check the KeyLocator name of a packet against one of the rule checkers
+      bool checkKeyLocator(const Checker &checker, const ::ndn::Name &name, const ::ndn::Name &klName) const;
+
+      size_t size() const;
+      const std::vector<CustomMembershipSet> &getMemberships() const;
+
+      /// @brief literal name prefix of an anchored NDN regex ("^<a><b><>*$" => /a/b)
+      static ::ndn::Name extractLiteralPrefix(const std::string &regex);
+
+    private:
+      struct TrieNode {
+        std::map<::ndn::name::Component, std::unique_ptr<TrieNode>> children;
+        std::vector<size_t> rules;
+      };
+
+      void checkThread() const;
+      void addRule(const ::ndn::security::v2::validator_config::ConfigSection &ruleSection);
+      Checker parseChecker(const ::ndn::security::v2::validator_config::ConfigSection &checkerSection);
+
+    private:
+      std::vector<Rule> m_rules;
+      std::vector<CustomMembershipSet> m_memberships;
+      TrieNode m_dataRoot;
+      TrieNode m_interestRoot;
+      std::thread::id m_owner; ///< @brief thread that loaded the index
+    };
+
+    /**
+     * @brief Validation policy backed by a CustomRuleIndex.
+     *
+     * Drop-in replacement for ValidationPolicyConfig for the subset of the validator.conf format
+     * generated by this project (name filters, customized checkers with key-locator name regex or
+     * hyper-relation), extended with a zone "membership" section.
+     */
+    class CustomValidationPolicy : public ::ndn::security::v2::ValidationPolicy {
+    public:
+      CustomValidationPolicy();
+
+      void setRuleIndex(std::shared_ptr<const CustomRuleIndex> index);
+      void setBypass(bool bypass);
+      /// @brief HMAC key by KeyLocator name (nullptr = unknown), for hmac-sha256 checkers
+      void setGroupKeyLookup(std::function<::ndn::ConstBufferPtr(const ::ndn::Name &)> lookup);
+
+      /// @brief policy check alone (no certificate fetched): a checker of the rule of the Data accepts its
+      ///        KeyLocator name. False in bypass mode and for HMAC Data, which need no certificate.
+      bool isAllowed(const ::ndn::Data &data) const;
+
+    protected:
+      void checkPolicy(const ::ndn::Data &data,
+                       const std::shared_ptr<::ndn::security::v2::ValidationState> &state,
+                       const ValidationContinuation &continueValidation) override;
+
+      void checkPolicy(const ::ndn::Interest &interest,
+                       const std::shared_ptr<::ndn::security::v2::ValidationState> &state,
+                       const ValidationContinuation &continueValidation) override;
+
+    private:
+      const CustomRuleIndex::Checker *findChecker(const ::ndn::Name &name, bool isInterest, uint32_t sigType,
+                                                  const ::ndn::Name &klName, std::string &error) const;
+      void checkRule(const ::ndn::Name &name, bool isInterest, uint32_t sigType, const ::ndn::Name &klName,
+                     const std::shared_ptr<::ndn::security::v2::ValidationState> &state,
+                     const ValidationContinuation &continueValidation, const ::ndn::Data *data = nullptr);
+      void checkGroupKey(const ::ndn::Data *data, const ::ndn::Name &klName,
+                         const std::shared_ptr<::ndn::security::v2::ValidationState> &state,
+                         const ValidationContinuation &continueValidation);
+
+    private:
+      std::shared_ptr<const CustomRuleIndex> m_index;
+      bool m_shouldBypass;
+      std::function<::ndn::ConstBufferPtr(const ::ndn::Name &)> m_groupKeyLookup;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_RULE_INDEX_H_
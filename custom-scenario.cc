@@ -0,0 +1,121 @@
+// custom-scenario.cpp
+
+#include "custom-scenario.hpp"
+
+// boost libs
+#include <boost/property_tree/info_parser.hpp>
+
+// system libs
+#include <algorithm>
+#include <stdexcept> // for standard exception classes
+
+NS_LOG_COMPONENT_DEFINE("CustomScenario");
+
+namespace ns3 {
+  namespace ndn {
+
+    CustomScenario::CustomScenario(const std::string &filename) : m_hubs(std::make_shared<NodeContainer>()) {
+      boost::property_tree::ptree scenario;
+      try {
+        boost::property_tree::read_info(filename, scenario);
+      } catch(const std::exception &e) {
+        throw std::runtime_error("Failed to read scenario file='" + filename + "' - Error=" + e.what());
+      }
+
+      // 1st pass: zones and their hubs
+      for(const auto &item : scenario) {
+        if(item.first != "zone") {
+          throw std::runtime_error("Unknown scenario section '" + item.first + "' in file='" + filename +
+                                   "'");
+        }
+        auto zoneName = item.second.get<std::string>("name");
+        if(m_zones.find(zoneName) != m_zones.end()) {
+          throw std::runtime_error("Duplicated zone '" + zoneName + "' in file='" + filename + "'");
+        }
+        NS_LOG_INFO("Creating zone '" << zoneName << "' ...");
+        m_zones[zoneName] = std::make_shared<CustomZone>(zoneName, item.second.get<int>("producers", 1),
+                                                         item.second.get<int>("consumers", 1),
+                                                         item.second.get<int>("trust-anchors", 1));
+        auto workload = item.second.get_child_optional("workload");
+        if(workload) {
+          m_zones[zoneName]->setWorkload(parseWorkload(*workload));
+        }
+        m_zoneNames.push_back(zoneName);
+        m_hubs->Create(1);
+      }
+
+      // 2nd pass: consumers of one zone requesting content of another zone
+      for(const auto &item : scenario) {
+        auto contentZoneName = item.second.get<std::string>("consume", "");
+        if(contentZoneName.empty()) {
+          continue;
+        }
+        auto it = m_zones.find(contentZoneName);
+        if(it == m_zones.end()) {
+          throw std::runtime_error("Unknown zone '" + contentZoneName + "' in file='" + filename + "'");
+        }
+        m_zones[item.second.get<std::string>("name")]->setContentZone(it->second);
+      }
+    }
+
+    CustomScenario::~CustomScenario() {}
+
+    const std::map<std::string, std::shared_ptr<CustomZone>> &CustomScenario::getZones() { return m_zones; }
+    std::shared_ptr<NodeContainer> CustomScenario::getHubs() { return m_hubs; }
+
+    void CustomScenario::installLinks(PointToPointHelper &p2p) {
+      for(uint32_t i = 0; i < m_zoneNames.size(); i++) {
+        auto zone = m_zones[m_zoneNames[i]];
+        auto hub = m_hubs->Get(i);
+        // zone nodes => zone hub (star)
+        for(auto node : *zone->getTrustAnchors()) {
+          p2p.Install(node, hub);
+        }
+        for(auto node : *zone->getProducers()) {
+          p2p.Install(node, hub);
+        }
+        for(auto node : *zone->getConsumers()) {
+          p2p.Install(node, hub);
+        }
+        // zone hub => parent hub (binary tree, log(n) hops between zones)
+        if(i > 0) {
+          p2p.Install(hub, m_hubs->Get((i - 1) / 2));
+        }
+      }
+    }
+
+    //////////////////////
+    //     PRIVATE
+    //////////////////////
+
+    CustomZone::Workload CustomScenario::parseWorkload(const boost::property_tree::ptree &section) {
+      CustomZone::Workload workload;
+      workload.prefixes.clear();
+      for(const auto &item : section) {
+        if(item.first != "prefix") {
+          continue;
+        }
+        workload.prefixes.emplace_back(item.second.get<std::string>("name"),
+                                       item.second.get<uint32_t>("producers", 0),
+                                       item.second.get<double>("freshness", 2.0),
+                                       item.second.get<uint32_t>("payload", 1480));
+      }
+      if(workload.prefixes.empty()) {
+        workload.prefixes.emplace_back();
+      }
+      workload.zipfAlpha = section.get<double>("zipf-alpha", workload.zipfAlpha);
+      workload.rateMin = section.get<double>("rate-min", workload.rateMin);
+      workload.rateMax = section.get<double>("rate-max", std::max(workload.rateMin, workload.rateMax));
+      workload.lifetime = section.get<std::string>("lifetime", workload.lifetime);
+      workload.randomize = section.get<std::string>("randomize", workload.randomize);
+      workload.catalogSize = section.get<uint32_t>("catalog-size", workload.catalogSize);
+      workload.catalogAlpha = section.get<double>("catalog-alpha", workload.catalogAlpha);
+      workload.catalogQ = section.get<double>("catalog-q", workload.catalogQ);
+      workload.attachCertificate = section.get<bool>("attach-certificate", workload.attachCertificate);
+      workload.batchSize = section.get<uint32_t>("batch-size", workload.batchSize);
+      workload.groupKey = section.get<bool>("group-key", workload.groupKey);
+      return workload;
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,83 @@
+// custom-scenario.hpp
+
+#ifndef CUSTOM_SCENARIO_H
+#define CUSTOM_SCENARIO_H
+
+// default libraries
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// boost libs
+#include <boost/property_tree/ptree.hpp>
+
+// ns3 modules
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+// custom and auxiliary
+#include "custom-zone.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Zones of a simulation, read from a scenario file (INFO format).
+     *
+     * zone
+     * {
+     *   name /zoneA
+     *   trust-anchors 1
+     *   producers 2
+     *   consumers 4
+     *   consume /zoneB   ; optional, consumers request (and trust) content of another zone
+     *   workload         ; optional, CustomZone::Workload (default: /test/prefix on all producers)
+     *   {
+     *     prefix         ; one section per prefix, in popularity order
+     *     {
+     *       name /video
+     *       producers 2    ; 0 = all remaining producers
+     *       freshness 2.0
+     *       payload 1480
+     *     }
+     *     zipf-alpha 0.8 ; popularity of the prefixes among consumers
+     *     rate-min 5     ; consumer Interests/s drawn from [rate-min, rate-max]
+     *     rate-max 20
+     *     lifetime 1s
+     *     randomize uniform
+     *     catalog-size 1000 ; consumers request /<prefix>/<rank> (Zipf-Mandelbrot, 0 = only /<prefix>)
+     *     catalog-alpha 0.7
+     *     catalog-q 0.0
+     *     attach-certificate false ; producers bundle their certificate with content Data
+     *     batch-size 1 ; content Data signed per Merkle batch (1 = one signature per Data)
+     *     group-key false ; enrolled producers sign content Data with the zone group HMAC key
+     *   }
+     * }
+     *
+     * Every zone gets one hub (forwarder) node; zone nodes are linked to their hub and hubs form a
+     * binary tree, so the number of links grows linearly with the number of nodes.
+     */
+    class CustomScenario {
+    public:
+      CustomScenario(const std::string &filename);
+      ~CustomScenario();
+
+      const std::map<std::string, std::shared_ptr<CustomZone>> &getZones();
+      std::shared_ptr<NodeContainer> getHubs();
+
+      void installLinks(PointToPointHelper &p2p);
+
+    private:
+      static CustomZone::Workload parseWorkload(const boost::property_tree::ptree &section);
+
+    private:
+      std::map<std::string, std::shared_ptr<CustomZone>> m_zones;
+      std::vector<std::string> m_zoneNames; ///< @brief zones in file order (hub i belongs to zone i)
+      std::shared_ptr<NodeContainer> m_hubs;
+    };
+  } // namespace ndn
+} // namespace ns3
+
+#endif /* CUSTOM_SCENARIO_H */
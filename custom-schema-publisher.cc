@@ -0,0 +1,86 @@
+// custom-schema-publisher.cpp
+
+#include "custom-schema-publisher.hpp"
+
+#include "custom-schema-tlv.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/security/signing-helpers.hpp"
+
+// system libs
+#include <algorithm>
+
+namespace ns3 {
+  namespace ndn {
+
+    CustomSchemaPublisher::CustomSchemaPublisher() : CustomSchemaPublisher(::ndn::Name(), 1) {}
+
+    CustomSchemaPublisher::CustomSchemaPublisher(const ::ndn::Name &contentPrefix, size_t segmentSize)
+        : m_contentPrefix(contentPrefix), m_segmentSize(std::max<size_t>(segmentSize, 1)),
+          m_segmentFreshness(::ndn::time::hours(1)), m_manifestFreshness(1), m_version(0) {}
+
+    void CustomSchemaPublisher::setFreshness(::ndn::time::milliseconds segmentFreshness,
+                                             ::ndn::time::milliseconds manifestFreshness) {
+      m_segmentFreshness = segmentFreshness;
+      m_manifestFreshness = manifestFreshness;
+    }
+
+    bool CustomSchemaPublisher::update(::ndn::Buffer payload, size_t enrolled,
+                                       const ::ndn::security::SigningInfo &signingInfo, const Signer &sign) {
+      if(m_manifest != nullptr && payload == m_payload) {
+        return false;
+      }
+      m_version = CustomSchemaTlv::makeVersion(enrolled, payload.data(), payload.size());
+      m_payload = std::move(payload);
+      m_segments.clear();
+
+      // segments are only signed with a digest, the manifest carries their implicit digests
+      CustomSchemaTlv::Manifest manifest;
+      manifest.version = m_version;
+      auto versionPrefix = m_contentPrefix.deepCopy().appendVersion(m_version);
+      size_t nSegments = std::max<size_t>(1, (m_payload.size() + m_segmentSize - 1) / m_segmentSize);
+      for(size_t segment = 0; segment < nSegments; segment++) {
+        size_t offset = segment * m_segmentSize;
+        size_t length = std::min<size_t>(m_segmentSize, m_payload.size() - offset);
+        auto data = std::make_shared<::ndn::Data>(versionPrefix.deepCopy().appendSegment(segment));
+        data->setFinalBlock(::ndn::name::Component::fromSegment(nSegments - 1));
+        data->setFreshnessPeriod(m_segmentFreshness); // immutable (named by version and digest)
+        data->setContent(m_payload.data() + offset, length);
+        sign(*data, ::ndn::security::signingWithSha256());
+        manifest.digests.push_back(data->getFullName().get(-1));
+        m_segments.push_back(data);
+      }
+
+      m_manifest = std::make_shared<::ndn::Data>(m_contentPrefix);
+      m_manifest->setFreshnessPeriod(m_manifestFreshness);
+      m_manifest->setContent(CustomSchemaTlv::encodeManifest(manifest));
+      sign(*m_manifest, signingInfo);
+      return true;
+    }
+
+    std::shared_ptr<::ndn::Data> CustomSchemaPublisher::findSegment(const ::ndn::Interest &interest) const {
+      // /<zone>/SCHEMA/CONTENT/v=<n>/seg=<k>[/<implicit digest>]
+      auto &name = interest.getName();
+      if(!m_contentPrefix.isPrefixOf(name) || name.size() < m_contentPrefix.size() + 2) {
+        return nullptr;
+      }
+      auto &versionComponent = name.get(m_contentPrefix.size());
+      auto &segmentComponent = name.get(m_contentPrefix.size() + 1);
+      if(!versionComponent.isVersion() || versionComponent.toVersion() != m_version ||
+         !segmentComponent.isSegment() || segmentComponent.toSegment() >= m_segments.size()) {
+        return nullptr;
+      }
+      auto &segment = m_segments[segmentComponent.toSegment()];
+      return (interest.matchesData(*segment) ? segment : nullptr);
+    }
+
+    uint64_t CustomSchemaPublisher::getVersion() const { return m_version; }
+
+    const ::ndn::Buffer &CustomSchemaPublisher::getPayload() const { return m_payload; }
+
+    std::shared_ptr<::ndn::Data> CustomSchemaPublisher::getManifest() const { return m_manifest; }
+
+    size_t CustomSchemaPublisher::getSegmentCount() const { return m_segments.size(); }
+
+  } // namespace ndn
+} // namespace ns3
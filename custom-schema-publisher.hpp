@@ -0,0 +1,73 @@
+// custom-schema-publisher.hpp
+
+#ifndef CUSTOM_SCHEMA_PUBLISHER_H_
+#define CUSTOM_SCHEMA_PUBLISHER_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/data.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/buffer.hpp"
+#include "ns3/ndnSIM/ndn-cxx/interest.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/signing-info.hpp"
+
+// system libs
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Segmented SCHEMA served by a trust anchor: /<zone>/SCHEMA/CONTENT manifest (signed by the zone
+     * KEY) and its digest-signed segments /<zone>/SCHEMA/CONTENT/v=<n>/seg=<k>.
+     *
+     * Only depends on ndn-cxx (shared by CustomTrustAnchor and EmuTrustAnchor); the app signs the packets,
+     * so signatures are charged to it as any other Data it signs.
+     */
+    class CustomSchemaPublisher {
+    public:
+      typedef std::function<void(::ndn::Data &data, const ::ndn::security::SigningInfo &signingInfo)> Signer;
+
+    public:
+      CustomSchemaPublisher();
+      CustomSchemaPublisher(const ::ndn::Name &contentPrefix, size_t segmentSize);
+
+      /// @brief freshness of the segments (immutable) and of the manifest (latest version) built next
+      void setFreshness(::ndn::time::milliseconds segmentFreshness,
+                        ::ndn::time::milliseconds manifestFreshness);
+
+      /**
+       * @brief split the payload into segments and sign its manifest, unless the payload is the served one
+       *
+       * The version is CustomSchemaTlv::makeVersion(enrolled, payload), so the trust anchors of a zone
+       * serving the same schema serve the same version. Segments are digest-signed, the manifest is signed
+       * with signingInfo (zone KEY). Returns true if a new version was built.
+       */
+      bool update(::ndn::Buffer payload, size_t enrolled, const ::ndn::security::SigningInfo &signingInfo,
+                  const Signer &sign);
+
+      /// @brief segment of the served version named by the Interest (nullptr if none, or digest mismatch)
+      std::shared_ptr<::ndn::Data> findSegment(const ::ndn::Interest &interest) const;
+
+      uint64_t getVersion() const;
+      const ::ndn::Buffer &getPayload() const;
+      std::shared_ptr<::ndn::Data> getManifest() const;
+      size_t getSegmentCount() const;
+
+    private:
+      ::ndn::Name m_contentPrefix; ///< @brief /<zone>/SCHEMA/CONTENT
+      size_t m_segmentSize;        ///< @brief max payload bytes per segment
+      ::ndn::time::milliseconds m_segmentFreshness;
+      ::ndn::time::milliseconds m_manifestFreshness;
+
+      uint64_t m_version;
+      ::ndn::Buffer m_payload;
+      std::shared_ptr<::ndn::Data> m_manifest;
+      std::vector<std::shared_ptr<::ndn::Data>> m_segments;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_SCHEMA_PUBLISHER_H_
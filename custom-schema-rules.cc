@@ -0,0 +1,53 @@
+// custom-schema-rules.cpp
+
+#include "custom-schema-rules.hpp"
+
+// system libs
+#include <sstream>
+
+namespace ns3 {
+  namespace ndn {
+
+    ::ndn::security::v2::validator_config::ConfigSection
+    CustomSchemaRules::createValidationRule(const std::string &dataRegex,
+                                            const std::string &keyLocatorRegex) {
+      ::ndn::security::v2::validator_config::ConfigSection rule;
+      rule.put("id", dataRegex);
+      rule.put("for", "data");
+      rule.put("filter.type", "name");
+      rule.put("filter.regex", dataRegex);
+      rule.put("checker.type", "customized");
+      rule.put("checker.sig-type", "rsa-sha256");
+      rule.put("checker.key-locator.type", "name");
+      rule.put("checker.key-locator.regex", keyLocatorRegex);
+      return rule;
+    }
+
+    std::string CustomSchemaRules::getValidationRegex(const ::ndn::Name &prefix) {
+      std::stringstream res;
+      for(auto &item : prefix) {
+        res << "<" << item << ">";
+      }
+      return res.str();
+    }
+
+    ::ndn::security::v2::validator_config::ConfigSection
+    CustomSchemaRules::createZoneRule(const ::ndn::Name &prefix, const ::ndn::Name &zonePrefix) {
+      return createValidationRule("^" + getValidationRegex(prefix) + "<>*$",
+                                  "^" + getValidationRegex(zonePrefix) + "<KEY><>{1,3}$");
+    }
+
+    ::ndn::security::v2::validator_config::ConfigSection
+    CustomSchemaRules::createProducerKeyRule(const ::ndn::Name &identityName, const ::ndn::Name &zonePrefix) {
+      return createValidationRule("^" + getValidationRegex(identityName) + "<KEY><>{1,3}$",
+                                  "^" + getValidationRegex(zonePrefix) + "<KEY><>{1,3}$");
+    }
+
+    ::ndn::security::v2::validator_config::ConfigSection
+    CustomSchemaRules::createProducerAppRule(const ::ndn::Name &identityName) {
+      auto identityRegex = getValidationRegex(identityName);
+      return createValidationRule("^" + identityRegex + "[^<KEY>]*$", "^" + identityRegex + "<KEY><>{1,3}$");
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,47 @@
+// custom-schema-rules.hpp
+
+#ifndef CUSTOM_SCHEMA_RULES_H_
+#define CUSTOM_SCHEMA_RULES_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validator-config/common.hpp"
+
+// system libs
+#include <string>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Validation rules of the trust schema, as issued by the trust anchors.
+     *
+     * Only depends on ndn-cxx, so the simulated (CustomTrustAnchor) and emulated (EmuTrustAnchor) trust
+     * anchors build the same rules.
+     */
+    class CustomSchemaRules {
+    public:
+      /// @brief rsa-sha256 rule: Data names matching dataRegex, signed by a KEY matching keyLocatorRegex
+      static ::ndn::security::v2::validator_config::ConfigSection
+      createValidationRule(const std::string &dataRegex, const std::string &keyLocatorRegex);
+
+      /// @brief NDN regex matching the components of the prefix (<a><b>...)
+      static std::string getValidationRegex(const ::ndn::Name &prefix);
+
+      /// @brief zone protocol Data (SIGN, SCHEMA, GROUPKEY) under the prefix, signed by the zone KEY
+      static ::ndn::security::v2::validator_config::ConfigSection
+      createZoneRule(const ::ndn::Name &prefix, const ::ndn::Name &zonePrefix);
+
+      /// @brief KEY of an enrolled identity, signed by the zone KEY
+      static ::ndn::security::v2::validator_config::ConfigSection
+      createProducerKeyRule(const ::ndn::Name &identityName, const ::ndn::Name &zonePrefix);
+
+      /// @brief APP Data of an enrolled identity, signed by its own KEY
+      static ::ndn::security::v2::validator_config::ConfigSection
+      createProducerAppRule(const ::ndn::Name &identityName);
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_SCHEMA_RULES_H_
@@ -0,0 +1,197 @@
+// custom-schema-store.cpp
+
+#include "custom-schema-store.hpp"
+#include "custom-profiler.hpp"
+
+// NS3
+#include "ns3/log.h"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/util/io.hpp"
+
+// boost libs
+#include <boost/property_tree/info_parser.hpp>
+
+// system libs
+#include <algorithm>
+#include <stdexcept> // for standard exception classes
+#include <sys/stat.h>
+
+NS_LOG_COMPONENT_DEFINE("CustomSchemaStore");
+
+namespace ns3 {
+  namespace ndn {
+
+    CustomSchemaStore &CustomSchemaStore::getInstance() {
+      static CustomSchemaStore instance;
+      return instance;
+    }
+
+    CustomSchemaStore::CustomSchemaStore()
+        : m_writesInProgress(0), m_stop(false), m_writer(&CustomSchemaStore::runWriter, this) {}
+
+    CustomSchemaStore::~CustomSchemaStore() {
+      try {
+        flush();
+      } catch(const std::exception &) {
+        // already logged by flush()
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+      m_cv.notify_all();
+      m_writer.join();
+    }
+
+    CustomSchemaStore::Schema CustomSchemaStore::readSchema(const std::string &filename) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto &entry = m_entries[filename];
+      if(entry.schema.rules == nullptr ||
+         (!entry.pendingWrite && entry.mtime != getModificationTime(filename))) {
+        // first read, or file changed on disk
+        CUSTOM_PROFILE_SCOPE("read_info(file)");
+        auto rules = std::make_shared<::ndn::security::v2::validator_config::ConfigSection>();
+        boost::property_tree::read_info(filename, *rules);
+        entry.schema.rules = rules;
+        entry.schema.index = nullptr;
+        entry.mtime = getModificationTime(filename);
+      }
+      if(entry.schema.index == nullptr) {
+        auto index = std::make_shared<CustomRuleIndex>();
+        index->load(*entry.schema.rules);
+        entry.schema.index = index;
+      }
+      return entry.schema;
+    }
+
+    void CustomSchemaStore::writeSchema(const std::string &filename,
+                                        const ::ndn::security::v2::validator_config::ConfigSection &rules) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto &entry = m_entries[filename];
+      entry.schema.rules = std::make_shared<::ndn::security::v2::validator_config::ConfigSection>(rules);
+      entry.schema.index = nullptr; // compiled on first read
+      entry.pendingWrite = true;
+      queueWrite(filename);
+    }
+
+    std::shared_ptr<const ::ndn::security::v2::Certificate>
+    CustomSchemaStore::readCertificate(const std::string &filename) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto &entry = m_entries[filename];
+      if(entry.cert == nullptr || (!entry.pendingWrite && entry.mtime != getModificationTime(filename))) {
+        auto cert = ::ndn::io::load<::ndn::security::v2::Certificate>(filename);
+        if(cert == nullptr) {
+          throw std::runtime_error("Cannot load certificate from '" + filename + "'");
+        }
+        entry.cert = cert;
+        entry.mtime = getModificationTime(filename);
+      }
+      return entry.cert;
+    }
+
+    void CustomSchemaStore::writeCertificate(const std::string &filename,
+                                             const ::ndn::security::v2::Certificate &cert) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto &entry = m_entries[filename];
+      entry.cert = std::make_shared<::ndn::security::v2::Certificate>(cert);
+      entry.pendingWrite = true;
+      queueWrite(filename);
+    }
+
+    ::ndn::ConstBufferPtr CustomSchemaStore::readGroupKey(const ::ndn::Name &keyName) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_groupKeys.find(keyName);
+      return (it != m_groupKeys.end() ? it->second : nullptr);
+    }
+
+    void CustomSchemaStore::writeGroupKey(const ::ndn::Name &keyName, ::ndn::ConstBufferPtr key) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_groupKeys[keyName] = key;
+    }
+
+    bool CustomSchemaStore::exists(const std::string &filename) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_entries.find(filename);
+      return (it != m_entries.end() && it->second.pendingWrite) || getModificationTime(filename) >= 0;
+    }
+
+    void CustomSchemaStore::flush() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return m_writeQueue.empty() && m_writesInProgress == 0; });
+      if(m_writeErrors.empty()) {
+        return;
+      }
+      // reported here, on the caller thread (NS_LOG is not safe from the writer thread)
+      auto errors = std::move(m_writeErrors);
+      m_writeErrors.clear();
+      lock.unlock();
+      for(const auto &error : errors) {
+        NS_LOG_WARN(error);
+      }
+      throw std::runtime_error(errors.front());
+    }
+
+    //////////////////////
+    //     PRIVATE
+    //////////////////////
+
+    /// @return modification time in ns, -1 if file does not exist
+    int64_t CustomSchemaStore::getModificationTime(const std::string &filename) {
+      struct stat info;
+      if(stat(filename.c_str(), &info) != 0) {
+        return -1;
+      }
+      return static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    }
+
+    /// @brief must be called with m_mutex locked
+    void CustomSchemaStore::queueWrite(const std::string &filename) {
+      // several updates of the same file are coalesced into one write of the latest copy
+      if(std::find(m_writeQueue.begin(), m_writeQueue.end(), filename) == m_writeQueue.end()) {
+        m_writeQueue.push_back(filename);
+      }
+      m_cv.notify_all();
+    }
+
+    void CustomSchemaStore::runWriter() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while(true) {
+        m_cv.wait(lock, [this] { return m_stop || !m_writeQueue.empty(); });
+        if(m_writeQueue.empty()) { // m_stop
+          return;
+        }
+        auto filename = m_writeQueue.front();
+        m_writeQueue.pop_front();
+        auto rules = m_entries[filename].schema.rules;
+        auto cert = m_entries[filename].cert;
+        m_writesInProgress++;
+
+        // write latest snapshot without holding the lock
+        lock.unlock();
+        try {
+          if(cert != nullptr) {
+            ::ndn::io::save(*cert, filename);
+          } else {
+            CUSTOM_PROFILE_SCOPE("write_info(file)");
+            boost::property_tree::write_info(filename, *rules);
+          }
+        } catch(const std::exception &e) {
+          lock.lock();
+          m_writeErrors.push_back("Failed to write file='" + filename + "' - Error=" + e.what());
+          lock.unlock();
+        }
+        lock.lock();
+
+        auto &entry = m_entries[filename];
+        entry.mtime = getModificationTime(filename);
+        if(std::find(m_writeQueue.begin(), m_writeQueue.end(), filename) == m_writeQueue.end()) {
+          entry.pendingWrite = false;
+        }
+        m_writesInProgress--;
+        m_cv.notify_all();
+      }
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,95 @@
+// custom-schema-store.hpp
+
+#ifndef CUSTOM_SCHEMA_STORE_H_
+#define CUSTOM_SCHEMA_STORE_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/buffer.hpp"
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/certificate.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validator-config/common.hpp"
+
+// system libs
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// custom includes
+#include "custom-rule-index.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Process-wide cache of trust schema (.conf) and trust anchor (.cert) files.
+     *
+     * Each file is parsed once and shared by every app that reads it; it is only parsed again when its
+     * modification time changes on disk. Writes update the in-memory copy immediately and are persisted
+     * by a background thread, so the simulator event loop never blocks on file I/O.
+     */
+    class CustomSchemaStore {
+    public:
+      struct Schema {
+        std::shared_ptr<const ::ndn::security::v2::validator_config::ConfigSection> rules;
+        std::shared_ptr<const CustomRuleIndex> index; ///< @brief rules compiled once for all readers
+      };
+
+    public:
+      static CustomSchemaStore &getInstance();
+
+      ~CustomSchemaStore();
+
+      Schema readSchema(const std::string &filename);
+      void writeSchema(const std::string &filename,
+                       const ::ndn::security::v2::validator_config::ConfigSection &rules);
+
+      std::shared_ptr<const ::ndn::security::v2::Certificate> readCertificate(const std::string &filename);
+      void writeCertificate(const std::string &filename, const ::ndn::security::v2::Certificate &cert);
+
+      /// @brief zone group keys (memory only), shared out-of-band as the trust anchor .cert (nullptr = none)
+      ::ndn::ConstBufferPtr readGroupKey(const ::ndn::Name &keyName);
+      void writeGroupKey(const ::ndn::Name &keyName, ::ndn::ConstBufferPtr key);
+
+      /// @brief true if the file exists on disk or is waiting to be written
+      bool exists(const std::string &filename);
+
+      /// @brief block until every pending write is on disk (throws if any of them failed)
+      void flush();
+
+    private:
+      struct Entry {
+        Schema schema;
+        std::shared_ptr<const ::ndn::security::v2::Certificate> cert;
+        int64_t mtime = -1;        ///< @brief modification time (ns) of the parsed/written file
+        bool pendingWrite = false; ///< @brief in-memory copy is newer than the file
+      };
+
+    private:
+      CustomSchemaStore();
+
+      static int64_t getModificationTime(const std::string &filename);
+
+      void queueWrite(const std::string &filename);
+      void runWriter();
+
+    private:
+      std::mutex m_mutex;
+      std::condition_variable m_cv;
+      std::map<std::string, Entry> m_entries;
+      std::map<::ndn::Name, ::ndn::ConstBufferPtr> m_groupKeys;
+      std::deque<std::string> m_writeQueue;
+      std::vector<std::string> m_writeErrors; ///< @brief failed writes, reported by flush()
+      size_t m_writesInProgress;
+      bool m_stop;
+      std::thread m_writer;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_SCHEMA_STORE_H_
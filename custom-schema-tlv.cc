@@ -0,0 +1,250 @@
+// custom-schema-tlv.cpp
+
+#include "custom-schema-tlv.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/block-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/tlv.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/sha256.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/string-helper.hpp"
+
+// system libs
+#include <stdexcept> // for standard exception classes
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    namespace {
+
+      using ConfigSection = ::ndn::security::v2::validator_config::ConfigSection;
+
+      enum class Kind { SECTION, STRING, SIG_TYPE, BOOLEAN, NUMBER, HEX };
+
+      struct Field {
+        const char *key;
+        uint32_t type;
+        Kind kind;
+        const std::vector<Field> *children;
+      };
+
+      const std::vector<Field> HYPER_RELATION_FIELDS = {
+          {"k-regex", CustomSchemaTlv::KRegex, Kind::STRING, nullptr},
+          {"k-expand", CustomSchemaTlv::KExpand, Kind::STRING, nullptr},
+          {"h-relation", CustomSchemaTlv::HRelation, Kind::STRING, nullptr},
+          {"p-regex", CustomSchemaTlv::PRegex, Kind::STRING, nullptr},
+          {"p-expand", CustomSchemaTlv::PExpand, Kind::STRING, nullptr},
+      };
+
+      const std::vector<Field> KEY_LOCATOR_FIELDS = {
+          {"type", CustomSchemaTlv::FieldType, Kind::STRING, nullptr},
+          {"regex", CustomSchemaTlv::Regex, Kind::STRING, nullptr},
+          {"enrolled", CustomSchemaTlv::Enrolled, Kind::BOOLEAN, nullptr},
+          {"hyper-relation", CustomSchemaTlv::HyperRelation, Kind::SECTION, &HYPER_RELATION_FIELDS},
+      };
+
+      const std::vector<Field> CHECKER_FIELDS = {
+          {"type", CustomSchemaTlv::FieldType, Kind::STRING, nullptr},
+          {"sig-type", CustomSchemaTlv::SigType, Kind::SIG_TYPE, nullptr},
+          {"key-locator", CustomSchemaTlv::KeyLocator, Kind::SECTION, &KEY_LOCATOR_FIELDS},
+      };
+
+      const std::vector<Field> FILTER_FIELDS = {
+          {"type", CustomSchemaTlv::FieldType, Kind::STRING, nullptr},
+          {"regex", CustomSchemaTlv::Regex, Kind::STRING, nullptr},
+      };
+
+      const std::vector<Field> RULE_FIELDS = {
+          {"id", CustomSchemaTlv::Id, Kind::STRING, nullptr},
+          {"for", CustomSchemaTlv::For, Kind::STRING, nullptr},
+          {"filter", CustomSchemaTlv::Filter, Kind::SECTION, &FILTER_FIELDS},
+          {"checker", CustomSchemaTlv::Checker, Kind::SECTION, &CHECKER_FIELDS},
+      };
+
+      const std::vector<Field> TRUST_ANCHOR_FIELDS = {
+          {"type", CustomSchemaTlv::FieldType, Kind::STRING, nullptr},
+          {"file-name", CustomSchemaTlv::FileName, Kind::STRING, nullptr},
+      };
+
+      const std::vector<Field> MEMBERSHIP_FIELDS = {
+          {"zone", CustomSchemaTlv::Zone, Kind::STRING, nullptr},
+          {"type", CustomSchemaTlv::FieldType, Kind::STRING, nullptr},
+          {"id", CustomSchemaTlv::Id, Kind::STRING, nullptr},
+          {"hashes", CustomSchemaTlv::Hashes, Kind::NUMBER, nullptr},
+          {"count", CustomSchemaTlv::Count, Kind::NUMBER, nullptr},
+          {"filter", CustomSchemaTlv::BloomFilter, Kind::HEX, nullptr},
+      };
+
+      const std::vector<Field> SCHEMA_FIELDS = {
+          {"rule", CustomSchemaTlv::Rule, Kind::SECTION, &RULE_FIELDS},
+          {"trust-anchor", CustomSchemaTlv::TrustAnchor, Kind::SECTION, &TRUST_ANCHOR_FIELDS},
+          {"membership", CustomSchemaTlv::Membership, Kind::SECTION, &MEMBERSHIP_FIELDS},
+      };
+
+      uint64_t sigTypeToNumber(const std::string &sigType) {
+        if(sigType == "rsa-sha256") {
+          return ::ndn::tlv::SignatureSha256WithRsa;
+        } else if(sigType == "ecdsa-sha256") {
+          return ::ndn::tlv::SignatureSha256WithEcdsa;
+        } else if(sigType == "sha256") {
+          return ::ndn::tlv::DigestSha256;
+        } else if(sigType == "hmac-sha256") {
+          return ::ndn::tlv::SignatureHmacWithSha256;
+        }
+        throw std::runtime_error("Cannot encode sig-type '" + sigType + "'");
+      }
+
+      std::string sigTypeToString(uint64_t sigType) {
+        switch(sigType) {
+          case ::ndn::tlv::SignatureSha256WithRsa:
+            return "rsa-sha256";
+          case ::ndn::tlv::SignatureSha256WithEcdsa:
+            return "ecdsa-sha256";
+          case ::ndn::tlv::DigestSha256:
+            return "sha256";
+          case ::ndn::tlv::SignatureHmacWithSha256:
+            return "hmac-sha256";
+        }
+        throw std::runtime_error("Cannot decode sig-type " + std::to_string(sigType));
+      }
+
+      ::ndn::Block encodeSection(const ConfigSection &section, uint32_t type,
+                                 const std::vector<Field> &fields);
+
+      ::ndn::Block encodeField(const Field &field, const ConfigSection &item) {
+        const auto &value = item.get_value<std::string>();
+        switch(field.kind) {
+          case Kind::SECTION:
+            return encodeSection(item, field.type, *field.children);
+          case Kind::STRING:
+            return ::ndn::encoding::makeStringBlock(field.type, value);
+          case Kind::SIG_TYPE:
+            return ::ndn::encoding::makeNonNegativeIntegerBlock(field.type, sigTypeToNumber(value));
+          case Kind::BOOLEAN:
+            return ::ndn::encoding::makeNonNegativeIntegerBlock(field.type, (value == "true" ? 1 : 0));
+          case Kind::NUMBER:
+            return ::ndn::encoding::makeNonNegativeIntegerBlock(field.type, std::stoull(value));
+          case Kind::HEX: {
+            auto buffer = ::ndn::fromHex(value);
+            return ::ndn::encoding::makeBinaryBlock(field.type, buffer->data(), buffer->size());
+          }
+        }
+        throw std::logic_error("Unknown schema field kind");
+      }
+
+      ::ndn::Block encodeSection(const ConfigSection &section, uint32_t type,
+                                 const std::vector<Field> &fields) {
+        ::ndn::Block block(type);
+        for(const auto &item : section) {
+          const Field *field = nullptr;
+          for(const auto &candidate : fields) {
+            if(item.first == candidate.key) {
+              field = &candidate;
+              break;
+            }
+          }
+          if(field == nullptr) {
+            throw std::runtime_error("Cannot encode schema field '" + item.first + "'");
+          }
+          block.push_back(encodeField(*field, item.second));
+        }
+        block.encode();
+        return block;
+      }
+
+      ConfigSection decodeSection(const ::ndn::Block &block, const std::vector<Field> &fields);
+
+      ConfigSection decodeField(const Field &field, const ::ndn::Block &element) {
+        switch(field.kind) {
+          case Kind::SECTION:
+            return decodeSection(element, *field.children);
+          case Kind::STRING:
+            return ConfigSection(::ndn::encoding::readString(element));
+          case Kind::SIG_TYPE:
+            return ConfigSection(sigTypeToString(::ndn::encoding::readNonNegativeInteger(element)));
+          case Kind::BOOLEAN:
+            return ConfigSection(::ndn::encoding::readNonNegativeInteger(element) ? "true" : "false");
+          case Kind::NUMBER:
+            return ConfigSection(std::to_string(::ndn::encoding::readNonNegativeInteger(element)));
+          case Kind::HEX:
+            return ConfigSection(::ndn::toHex(element.value(), element.value_size()));
+        }
+        throw std::logic_error("Unknown schema field kind");
+      }
+
+      ConfigSection decodeSection(const ::ndn::Block &block, const std::vector<Field> &fields) {
+        block.parse();
+        ConfigSection section;
+        for(const auto &element : block.elements()) {
+          const Field *field = nullptr;
+          for(const auto &candidate : fields) {
+            if(element.type() == candidate.type) {
+              field = &candidate;
+              break;
+            }
+          }
+          if(field == nullptr) {
+            throw std::runtime_error("Cannot decode schema TLV-TYPE " + std::to_string(element.type()));
+          }
+          section.push_back(std::make_pair(field->key, decodeField(*field, element)));
+        }
+        return section;
+      }
+
+    } // namespace
+
+    ::ndn::Block CustomSchemaTlv::encode(const ::ndn::security::v2::validator_config::ConfigSection &schema) {
+      return encodeSection(schema, Schema, SCHEMA_FIELDS);
+    }
+
+    ::ndn::security::v2::validator_config::ConfigSection CustomSchemaTlv::decode(const ::ndn::Block &block) {
+      if(block.type() != Schema) {
+        throw std::runtime_error("Unexpected TLV-TYPE " + std::to_string(block.type()) + " for schema");
+      }
+      return decodeSection(block, SCHEMA_FIELDS);
+    }
+
+    ::ndn::Block CustomSchemaTlv::encodeManifest(const Manifest &manifest) {
+      ::ndn::Block block(SchemaManifest);
+      block.push_back(::ndn::encoding::makeNonNegativeIntegerBlock(Version, manifest.version));
+      for(const auto &digest : manifest.digests) {
+        block.push_back(::ndn::encoding::makeBinaryBlock(SegmentDigest, digest.value(), digest.value_size()));
+      }
+      block.encode();
+      return block;
+    }
+
+    CustomSchemaTlv::Manifest CustomSchemaTlv::decodeManifest(const ::ndn::Block &block) {
+      if(block.type() != SchemaManifest) {
+        throw std::runtime_error("Unexpected TLV-TYPE " + std::to_string(block.type()) + " for manifest");
+      }
+      block.parse();
+      CustomSchemaTlv::Manifest manifest;
+      for(const auto &element : block.elements()) {
+        if(element.type() == Version) {
+          manifest.version = ::ndn::encoding::readNonNegativeInteger(element);
+        } else if(element.type() == SegmentDigest) {
+          manifest.digests.push_back(
+              ::ndn::name::Component::fromImplicitSha256Digest(element.value(), element.value_size()));
+        } else {
+          throw std::runtime_error("Cannot decode manifest TLV-TYPE " + std::to_string(element.type()));
+        }
+      }
+      return manifest;
+    }
+
+    bool CustomSchemaTlv::isTlv(const uint8_t *buf, size_t size) { return (size > 0 && buf[0] == Schema); }
+
+    uint64_t CustomSchemaTlv::makeVersion(size_t enrolled, const uint8_t *payload, size_t size) {
+      auto digest = ::ndn::util::Sha256::computeDigest(payload, size);
+      uint32_t low = 0;
+      for(size_t i = 0; i < sizeof(low); i++) {
+        low = (low << 8) | (*digest)[i];
+      }
+      return (static_cast<uint64_t>(enrolled + 1) << 32) | low;
+    }
+
+    uint32_t CustomSchemaTlv::getGeneration(uint64_t version) { return static_cast<uint32_t>(version >> 32); }
+
+  } // namespace ndn
+} // namespace ns3
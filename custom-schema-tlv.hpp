@@ -0,0 +1,93 @@
+// custom-schema-tlv.hpp
+
+#ifndef CUSTOM_SCHEMA_TLV_H_
+#define CUSTOM_SCHEMA_TLV_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/block.hpp"
+#include "ns3/ndnSIM/ndn-cxx/name-component.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validator-config/common.hpp"
+
+// system libs
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Binary TLV encoding of the trust schema (SCHEMA/CONTENT payload).
+     *
+     * Rules, filters, checkers, trust anchors and the membership set are encoded as typed TLV fields
+     * (application-specific TLV-TYPE range), with signature types as integers and Bloom filters as raw
+     * bytes. The INFO text format (CustomApp::getValidationRules) remains available for debugging.
+     */
+    class CustomSchemaTlv {
+    public:
+      enum Type : uint32_t {
+        Schema = 200,
+        Rule = 201,
+        Id = 202,
+        For = 203,
+        Filter = 204,
+        Checker = 205,
+        KeyLocator = 206,
+        HyperRelation = 207,
+        TrustAnchor = 208,
+        Membership = 209,
+        FieldType = 210,
+        Regex = 211,
+        SigType = 212,
+        Enrolled = 213,
+        KRegex = 214,
+        KExpand = 215,
+        HRelation = 216,
+        PRegex = 217,
+        PExpand = 218,
+        FileName = 219,
+        Hashes = 220,
+        Count = 221,
+        BloomFilter = 222,
+        SchemaManifest = 223,
+        Version = 224,
+        SegmentDigest = 225,
+        CertificateBundle = 226, ///< @brief AppMetaInfo of content Data: signer certificate chain
+        LeafIndex = 227,         ///< @brief SignatureValue of batch-signed Data (see CustomMerkleTree)
+        ProofDigest = 228,
+        GroupKey = 229, ///< @brief content of a zone group key Data (see CustomGroupKey)
+        EncryptedKey = 230,
+        Zone = 231, ///< @brief zone of a membership section
+      };
+
+      /// @brief signed index of a segmented schema: version and implicit digest of every segment
+      struct Manifest {
+        uint64_t version = 0;
+        std::vector<::ndn::name::Component> digests;
+      };
+
+    public:
+      static ::ndn::Block encode(const ::ndn::security::v2::validator_config::ConfigSection &schema);
+      static ::ndn::security::v2::validator_config::ConfigSection decode(const ::ndn::Block &block);
+
+      static ::ndn::Block encodeManifest(const Manifest &manifest);
+      static Manifest decodeManifest(const ::ndn::Block &block);
+
+      /// @brief true if the buffer starts with an encoded schema (as opposed to INFO text)
+      static bool isTlv(const uint8_t *buf, size_t size);
+
+      /**
+       * @brief SCHEMA version derived from the schema itself, so every trust anchor of a zone serving the
+       *        same enrolled set announces the same version: (enrolled identities + 1) << 32 | digest
+       *
+       * Versions are ordered by their generation (enrolled identities only ever grow); the digest part
+       * tells apart schemas of the same generation.
+       */
+      static uint64_t makeVersion(size_t enrolled, const uint8_t *payload, size_t size);
+      static uint32_t getGeneration(uint64_t version);
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_SCHEMA_TLV_H_
@@ -0,0 +1,220 @@
+// custom-snapshot.cpp
+
+#include "custom-snapshot.hpp"
+#include "custom-schema-tlv.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/util/string-helper.hpp"
+
+// NS3
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+
+// NDNSIM
+#include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+// boost libs
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+// system libs
+#include <stdexcept> // for standard exception classes
+
+NS_LOG_COMPONENT_DEFINE("CustomSnapshot");
+
+namespace ns3 {
+  namespace ndn {
+
+    namespace {
+
+      std::string blockToHex(const ::ndn::Block &block) { return ::ndn::toHex(block.wire(), block.size()); }
+
+      ::ndn::Block blockFromHex(const std::string &hex) { return ::ndn::Block(::ndn::fromHex(hex)); }
+
+    } // namespace
+
+    const std::string CustomSnapshot::PASSWORD = "snapshot";
+
+    CustomSnapshot &CustomSnapshot::getInstance() {
+      static CustomSnapshot instance;
+      return instance;
+    }
+
+    CustomSnapshot::CustomSnapshot() : m_loaded(false) {}
+
+    void CustomSnapshot::load(const std::string &filename) {
+      clear();
+      boost::property_tree::ptree root;
+      try {
+        boost::property_tree::read_info(filename, root);
+        for(const auto &item : root) {
+          const auto &section = item.second;
+          if(item.first == "identity") {
+            auto safeBag = blockFromHex(section.get<std::string>("safebag"));
+            m_identities[::ndn::Name(section.get<std::string>("name"))] =
+                std::make_shared<::ndn::security::SafeBag>(safeBag);
+          } else if(item.first == "schema") {
+            Schema schema;
+            schema.version = section.get<uint64_t>("version");
+            schema.payload = *::ndn::fromHex(section.get<std::string>("payload"));
+            m_schemas[::ndn::Name(section.get<std::string>("prefix"))] = schema;
+          } else if(item.first == "sign-response") {
+            auto data = std::make_shared<::ndn::Data>(blockFromHex(section.get<std::string>("data")));
+            m_signResponses[::ndn::Name(section.get<std::string>("zone"))][data->getName()] = data;
+          } else if(item.first == "route") {
+            Route route;
+            route.node = section.get<uint32_t>("node");
+            route.prefix = ::ndn::Name(section.get<std::string>("prefix"));
+            route.faceId = section.get<uint64_t>("face");
+            route.cost = section.get<uint64_t>("cost");
+            m_routes.push_back(route);
+          } else {
+            throw std::runtime_error("unknown section '" + item.first + "'");
+          }
+        }
+      } catch(const std::exception &e) {
+        clear();
+        throw std::runtime_error("Failed to load snapshot file='" + filename + "' - Error=" + e.what());
+      }
+      m_loaded = true;
+      NS_LOG_INFO("Loaded snapshot '" << filename << "' - identities=" << m_identities.size()
+                                      << " schemas=" << m_schemas.size() << " routes=" << m_routes.size());
+    }
+
+    void CustomSnapshot::save(const std::string &filename) const {
+      boost::property_tree::ptree root;
+      for(const auto &pairNameBag : m_identities) {
+        boost::property_tree::ptree section;
+        section.put("name", pairNameBag.first.toUri());
+        section.put("safebag", blockToHex(pairNameBag.second->wireEncode()));
+        root.add_child("identity", section);
+      }
+      for(const auto &pairPrefixSchema : m_schemas) {
+        boost::property_tree::ptree section;
+        section.put("prefix", pairPrefixSchema.first.toUri());
+        section.put("version", pairPrefixSchema.second.version);
+        section.put("payload", ::ndn::toHex(pairPrefixSchema.second.payload));
+        root.add_child("schema", section);
+      }
+      for(const auto &pairZoneResponses : m_signResponses) {
+        for(const auto &pairNameData : pairZoneResponses.second) {
+          boost::property_tree::ptree section;
+          section.put("zone", pairZoneResponses.first.toUri());
+          section.put("data", blockToHex(pairNameData.second->wireEncode()));
+          root.add_child("sign-response", section);
+        }
+      }
+      for(const auto &route : m_routes) {
+        boost::property_tree::ptree section;
+        section.put("node", route.node);
+        section.put("prefix", route.prefix.toUri());
+        section.put("face", route.faceId);
+        section.put("cost", route.cost);
+        root.add_child("route", section);
+      }
+      try {
+        boost::property_tree::write_info(filename, root);
+      } catch(const std::exception &e) {
+        throw std::runtime_error("Failed to save snapshot file='" + filename + "' - Error=" + e.what());
+      }
+      NS_LOG_INFO("Saved snapshot '" << filename << "' - identities=" << m_identities.size()
+                                     << " schemas=" << m_schemas.size() << " routes=" << m_routes.size());
+    }
+
+    void CustomSnapshot::clear() {
+      m_loaded = false;
+      m_identities.clear();
+      m_schemas.clear();
+      m_signResponses.clear();
+      m_routes.clear();
+    }
+
+    bool CustomSnapshot::isLoaded() const { return m_loaded; }
+
+    std::shared_ptr<const ::ndn::security::SafeBag>
+    CustomSnapshot::getIdentity(const ::ndn::Name &identity) const {
+      auto it = m_identities.find(identity);
+      return (it != m_identities.end() ? it->second : nullptr);
+    }
+
+    void CustomSnapshot::setIdentity(const ::ndn::Name &identity,
+                                     std::shared_ptr<const ::ndn::security::SafeBag> safeBag) {
+      m_identities[identity] = safeBag;
+    }
+
+    const CustomSnapshot::Schema *CustomSnapshot::getSchema(const ::ndn::Name &contentPrefix) const {
+      auto it = m_schemas.find(contentPrefix);
+      return (it != m_schemas.end() ? &it->second : nullptr);
+    }
+
+    void CustomSnapshot::setSchema(const ::ndn::Name &contentPrefix, const Schema &schema) {
+      auto it = m_schemas.find(contentPrefix);
+      if(it != m_schemas.end()) {
+        auto generation = CustomSchemaTlv::getGeneration(schema.version);
+        auto currentGeneration = CustomSchemaTlv::getGeneration(it->second.version);
+        if(generation < currentGeneration ||
+           (generation == currentGeneration && schema.version <= it->second.version)) {
+          return;
+        }
+      }
+      m_schemas[contentPrefix] = schema;
+    }
+
+    std::vector<std::shared_ptr<const ::ndn::Data>>
+    CustomSnapshot::getSignResponses(const ::ndn::Name &zone) const {
+      std::vector<std::shared_ptr<const ::ndn::Data>> responses;
+      auto it = m_signResponses.find(zone);
+      if(it != m_signResponses.end()) {
+        for(const auto &pairNameData : it->second) {
+          responses.push_back(pairNameData.second);
+        }
+      }
+      return responses;
+    }
+
+    void CustomSnapshot::addSignResponse(const ::ndn::Name &zone, const ::ndn::Data &data) {
+      m_signResponses[zone][data.getName()] = std::make_shared<::ndn::Data>(data);
+    }
+
+    void CustomSnapshot::addRoutes(Ptr<Node> node) {
+      auto l3 = node->GetObject<L3Protocol>();
+      if(l3 == nullptr) {
+        return;
+      }
+      for(const auto &entry : l3->getForwarder()->getFib()) {
+        for(const auto &nextHop : entry.getNextHops()) {
+          if(nextHop.getFace().getScope() == ::ndn::nfd::FACE_SCOPE_LOCAL) {
+            continue; // app faces (and their routes) are created again when the apps start
+          }
+          Route route;
+          route.node = node->GetId();
+          route.prefix = entry.getPrefix();
+          route.faceId = nextHop.getFace().getId();
+          route.cost = nextHop.getCost();
+          m_routes.push_back(route);
+        }
+      }
+    }
+
+    /// @brief must be run after the NDN stack is installed (network faces created)
+    void CustomSnapshot::restoreRoutes() const {
+      for(const auto &route : m_routes) {
+        if(route.node >= NodeList::GetNNodes()) {
+          NS_LOG_WARN("Skipping route '" << route.prefix << "' - unknown node " << route.node);
+          continue;
+        }
+        auto node = NodeList::GetNode(route.node);
+        auto l3 = node->GetObject<L3Protocol>();
+        auto face = (l3 != nullptr ? l3->getFaceById(route.faceId) : nullptr);
+        if(face == nullptr) {
+          NS_LOG_WARN("Skipping route '" << route.prefix << "' - unknown face " << route.faceId << " on node "
+                                         << route.node);
+          continue;
+        }
+        FibHelper::AddRoute(node, route.prefix, face, route.cost);
+      }
+    }
+
+  } // namespace ndn
+} // namespace ns3
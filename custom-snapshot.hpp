@@ -0,0 +1,97 @@
+// custom-snapshot.hpp
+
+#ifndef CUSTOM_SNAPSHOT_H_
+#define CUSTOM_SNAPSHOT_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/data.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/buffer.hpp"
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/safe-bag.hpp"
+
+// NS3
+#include "ns3/node.h"
+#include "ns3/ptr.h"
+
+// system libs
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Post-bootstrap state of a simulation, to start later runs in steady state (warm start).
+     *
+     * Holds the KEY and default certificate of every app identity (SafeBag), the SCHEMA served by every
+     * zone, the SIGN responses of the trust anchors and the FIB routes of every node. Apps restore their
+     * part in StartApplication, so a loaded snapshot skips key generation, SIGN, KEY fetch and schema
+     * distribution. Stored as an INFO file, binary fields hex-encoded:
+     *
+     * identity { name /zoneA/producer0  safebag <hex> }
+     * schema { prefix /zoneA/SCHEMA/CONTENT  version 3  payload <hex> }
+     * sign-response { zone /zoneA  data <hex> }
+     * route { node 3  prefix /zoneA  face 257  cost 0 }
+     */
+    class CustomSnapshot {
+    public:
+      /// @brief SCHEMA/CONTENT payload of a zone, as served by its trust anchors
+      struct Schema {
+        uint64_t version = 0;
+        ::ndn::Buffer payload;
+      };
+
+      struct Route {
+        uint32_t node;
+        ::ndn::Name prefix;
+        uint64_t faceId;
+        uint64_t cost;
+      };
+
+      static const std::string PASSWORD; ///< @brief encrypts the private keys of the SafeBags
+
+    public:
+      static CustomSnapshot &getInstance();
+
+      void load(const std::string &filename);
+      void save(const std::string &filename) const;
+      void clear();
+
+      /// @brief true if a snapshot was loaded (apps restore their state from it)
+      bool isLoaded() const;
+
+      /// @brief KEY and default certificate of an identity (nullptr = not in the snapshot)
+      std::shared_ptr<const ::ndn::security::SafeBag> getIdentity(const ::ndn::Name &identity) const;
+      void setIdentity(const ::ndn::Name &identity, std::shared_ptr<const ::ndn::security::SafeBag> safeBag);
+
+      /// @brief SCHEMA of a zone, by SCHEMA/CONTENT prefix (nullptr = not in the snapshot)
+      const Schema *getSchema(const ::ndn::Name &contentPrefix) const;
+      /// @brief keeps the latest generation (then the highest version) when several trust anchors of the zone
+      ///        set it, so the snapshot does not depend on the order they are written in
+      void setSchema(const ::ndn::Name &contentPrefix, const Schema &schema);
+
+      /// @brief SIGN Data issued by the trust anchors of a zone
+      std::vector<std::shared_ptr<const ::ndn::Data>> getSignResponses(const ::ndn::Name &zone) const;
+      void addSignResponse(const ::ndn::Name &zone, const ::ndn::Data &data);
+
+      /// @brief FIB routes of the node towards its network faces (app faces are set up by the apps)
+      void addRoutes(Ptr<Node> node);
+      void restoreRoutes() const;
+
+    private:
+      CustomSnapshot();
+
+    private:
+      bool m_loaded;
+      std::map<::ndn::Name, std::shared_ptr<const ::ndn::security::SafeBag>> m_identities;
+      std::map<::ndn::Name, Schema> m_schemas;
+      std::map<::ndn::Name, std::map<::ndn::Name, std::shared_ptr<const ::ndn::Data>>> m_signResponses;
+      std::vector<Route> m_routes;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // CUSTOM_SNAPSHOT_H_
@@ -5,19 +5,21 @@
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/packet.h"
-#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/block-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/verification-helpers.hpp"
 #include "ns3/ndnSIM/ndn-cxx/util/io.hpp"
 
 #include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
-#include <limits>
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -42,16 +44,66 @@ namespace ns3 {
                             MakeNameAccessor(&CustomTrustAnchor::m_zonePrefix), MakeNameChecker())
               .AddAttribute("TrustAnchorCert", "Trust Anchor .cert filename",
                             StringValue("/ndnSIM/ns-3/scratch/sim_bootsec/config/trustanchor.cert"),
-                            MakeStringAccessor(&CustomTrustAnchor::m_trustAnchorCert), MakeStringChecker());
-      // .AddAttribute("SchemaFreshness",
-      //               "Freshness of Schema data packets, if 0, then unlimited "
-      //               "freshness",
-      //               TimeValue(MicroSeconds(1)),
-      //               MakeTimeAccessor(&CustomTrustAnchor::m_schemaFreshness), MakeTimeChecker())
+                            MakeStringAccessor(&CustomTrustAnchor::m_trustAnchorCert), MakeStringChecker())
+              .AddAttribute("SchemaFormat", "Trust schema payload encoding: tlv (binary), info (text)",
+                            StringValue("tlv"), MakeStringAccessor(&CustomTrustAnchor::m_schemaFormat),
+                            MakeStringChecker())
+              .AddAttribute("SchemaSegmentSize", "Max payload size (bytes) of each SCHEMA segment",
+                            UintegerValue(1200),
+                            MakeUintegerAccessor(&CustomTrustAnchor::m_schemaSegmentSize),
+                            MakeUintegerChecker<uint32_t>(1))
+              .AddAttribute("SchemaMode",
+                            "Trust schema mode: explicit (2 rules per producer), hierarchical (fixed rules "
+                            "+ membership set)",
+                            StringValue("explicit"), MakeStringAccessor(&CustomTrustAnchor::m_schemaMode),
+                            MakeStringChecker())
+              .AddAttribute("MembershipType", "Membership set encoding (hierarchical mode): list, bloom",
+                            StringValue("list"), MakeStringAccessor(&CustomTrustAnchor::m_membershipType),
+                            MakeStringChecker())
+              .AddAttribute("MembershipBloomBits", "Bloom filter size in bits (MembershipType=bloom)",
+                            UintegerValue(8192),
+                            MakeUintegerAccessor(&CustomTrustAnchor::m_membershipBloomBits),
+                            MakeUintegerChecker<uint32_t>())
+              .AddAttribute("MaxConcurrentSign", "Max number of SIGN requests served at the same time",
+                            UintegerValue(4), MakeUintegerAccessor(&CustomTrustAnchor::m_maxConcurrentSign),
+                            MakeUintegerChecker<uint32_t>(1))
+              .AddAttribute("MaxSignQueue", "Max number of SIGN requests waiting (more are Nacked)",
+                            UintegerValue(64), MakeUintegerAccessor(&CustomTrustAnchor::m_maxSignQueue),
+                            MakeUintegerChecker<uint32_t>())
+              .AddAttribute("SignServiceTimeout", "Time to wait for the producer KEY of a SIGN request",
+                            TimeValue(Seconds(2.0)),
+                            MakeTimeAccessor(&CustomTrustAnchor::m_signServiceTimeout), MakeTimeChecker())
+              .AddTraceSource("SignQueueDepth", "Number of SIGN requests waiting for a slot",
+                              MakeTraceSourceAccessor(&CustomTrustAnchor::m_signQueueDepth),
+                              "ns3::TracedValueCallback::Uint32")
+              .AddTraceSource("SignServiceTime", "Time from SIGN Interest to signed certificate",
+                              MakeTraceSourceAccessor(&CustomTrustAnchor::m_signServiceTime),
+                              "ns3::ndn::CustomTrustAnchor::SignServiceTimeCallback")
+              .AddAttribute("AnchorIndex", "Index of this trust anchor in the zone (0 .. AnchorCount-1)",
+                            UintegerValue(0), MakeUintegerAccessor(&CustomTrustAnchor::m_anchorIndex),
+                            MakeUintegerChecker<uint32_t>())
+              .AddAttribute("AnchorCount", "Number of trust anchors sharing the zone KEY", UintegerValue(1),
+                            MakeUintegerAccessor(&CustomTrustAnchor::m_anchorCount),
+                            MakeUintegerChecker<uint32_t>(1))
+              .AddTraceSource("CertificateIssued", "Producer certificate signed and sent",
+                              MakeTraceSourceAccessor(&CustomTrustAnchor::m_certificateIssued),
+                              "ns3::ndn::CustomTrustAnchor::CertificateIssuedCallback")
+              .AddAttribute("SchemaSyncRetry", "Time to wait for a SCHEMA sync ack before sending it again",
+                            TimeValue(Seconds(1.0)), MakeTimeAccessor(&CustomTrustAnchor::m_schemaSyncRetry),
+                            MakeTimeChecker())
+              .AddAttribute("SchemaFreshness",
+                            "Freshness of the SCHEMA manifest (cached copies may lag new versions this long)",
+                            TimeValue(Seconds(1.0)), MakeTimeAccessor(&CustomTrustAnchor::m_schemaFreshness),
+                            MakeTimeChecker())
+              .AddAttribute("SchemaUpdateDelay",
+                            "Enrollments within this time are announced as one new SCHEMA version",
+                            TimeValue(MilliSeconds(10)),
+                            MakeTimeAccessor(&CustomTrustAnchor::m_schemaUpdateDelay), MakeTimeChecker());
       return tid;
     }
 
-    CustomTrustAnchor::CustomTrustAnchor() : CustomApp() {}
+    CustomTrustAnchor::CustomTrustAnchor()
+        : CustomApp(), m_schemaDirty(false), m_signInService(0), m_signQueueDepth(0) {}
     CustomTrustAnchor::~CustomTrustAnchor() {}
 
     void CustomTrustAnchor::StartApplication() {
@@ -60,11 +112,15 @@ namespace ns3 {
 
       // define zone KEY prefix
       m_zoneKeyPrefix = m_zonePrefix.deepCopy().append("KEY");
+      m_schemaSyncPrefix = m_schemaPrefix.deepCopy().append("SYNC");
 
       // clear validation rules , create trust anchor cert file , write trust schema
       clearValidationRules();
       createTrustAnchor();
+      restoreTrustAnchor();
       writeValidationRules();
+      m_schemaPublisher = CustomSchemaPublisher(m_schemaContentPrefix, m_schemaSegmentSize);
+      updateSchemaSegments();
 
       // disable validation temporarily
       // TODO fix this to enable AUTH protocol authentication
@@ -82,12 +138,18 @@ namespace ns3 {
       ndn::FibHelper::AddRoute(GetNode(), m_zoneKeyPrefix, m_face, 0);
       NS_LOG_INFO("Monitoring prefix '" << m_zoneKeyPrefix << "'");
 
+      // GROUPKEY to enrolled PRODUCERS
+      if(m_useGroupKey) {
+        ndn::FibHelper::AddRoute(GetNode(), m_groupKeyPrefix, m_face, 0);
+        NS_LOG_INFO("Monitoring prefix '" << m_groupKeyPrefix << "'");
+      }
+
       printKeyChain();
     }
 
     void CustomTrustAnchor::StopApplication() {
       ndn::CustomApp::StopApplication();
-      // no additional code needed
+      Simulator::Cancel(m_schemaUpdateEvent);
     }
 
     void CustomTrustAnchor::OnInterestKey(std::shared_ptr<const ndn::Interest> interest) {
@@ -100,14 +162,31 @@ namespace ns3 {
       data->setName(dataName);
 
       if(m_signPrefix.isPrefixOf(dataName)) {
-        // request key from producer
+        // admission control: one request per KEY, bounded concurrency and queue
         auto keyName = dataName.getSubName(m_signPrefix.size(), dataName.size() - m_signPrefix.size());
-        NS_LOG_INFO("Sending KEY request for '" << keyName << "' ...");
-        InterestOptions opts;
-        opts.canBePrefix = true;
-        opts.mustBeFresh = true;
-        sendInterest(keyName, m_signLifetime, opts);
+        if(!isResponsibleFor(keyName)) {
+          NS_LOG_INFO("SIGN request for '" << keyName << "' is served by another trust anchor");
+        } else if(m_signResponses.count(keyName) > 0) {
+          // already issued: same certificate again, without fetching the producer KEY
+          NS_LOG_INFO("Replaying SIGN response for '" << keyName << "'");
+          sendData(m_signResponses[keyName]);
+        } else if(m_signRequests.count(keyName) > 0) {
+          NS_LOG_INFO("SIGN request for '" << keyName << "' already pending, ignoring duplicate");
+        } else if(m_signInService < m_maxConcurrentSign) {
+          m_signRequests[keyName] = {Simulator::Now(), EventId(), false};
+          startSignRequest(keyName);
+        } else if(m_signQueue.size() < m_maxSignQueue) {
+          NS_LOG_INFO("Queueing SIGN request for '" << keyName << "' ...");
+          m_signRequests[keyName] = {Simulator::Now(), EventId(), false};
+          m_signQueue.push_back(keyName);
+          m_signQueueDepth = m_signQueue.size();
+        } else {
+          // saturated, the producer backs off
+          sendNack(interest, ::ndn::lp::NackReason::CONGESTION);
+        }
         return;
+      } else if(m_groupKeyPrefix.isPrefixOf(dataName)) {
+        sendGroupKey(interest);
       } else if(m_zoneKeyPrefix.isPrefixOf(dataName)) {
         sendCertificate(interest);
       }
@@ -117,62 +196,88 @@ namespace ns3 {
       NS_LOG_FUNCTION(interest->getName());
       ndn::CustomApp::OnInterestContent(interest);
 
-      // define Data packet response
       auto dataName = interest->getName();
-      auto data = make_shared<Data>();
-      data->setName(dataName);
-
-      if(m_schemaContentPrefix.isPrefixOf(dataName)) {
-        NS_LOG_INFO("Sending SCHEMA content for '" << m_schemaContentPrefix << "' ...");
-        data->setFreshnessPeriod(::ndn::time::milliseconds(1));
-        // data->setFreshnessPeriod(::ndn::time::milliseconds(m_schemaFreshness.GetMilliSeconds()));
-        std::string schemaRules = getValidationRules();
-        auto buffer = std::make_shared<::ndn::Buffer>(schemaRules.begin(), schemaRules.end());
-        data->setContent(buffer);
-
-        // Sign Data with default identity, send packet
-        m_keyChain.sign(*data, m_signingInfo);
-        sendData(data);
+      if(m_schemaSyncPrefix.isPrefixOf(dataName)) {
+        OnInterestSchemaSync(interest);
+        return;
+      } else if(m_schemaContentPrefix == dataName) {
+        NS_LOG_INFO("Sending SCHEMA manifest for '" << m_schemaContentPrefix << "' ...");
+        sendData(m_schemaPublisher.getManifest());
+        return;
+      } else if(m_schemaContentPrefix.isPrefixOf(dataName)) {
+        auto segment = m_schemaPublisher.findSegment(*interest);
+        if(segment == nullptr) {
+          NS_LOG_INFO("Dropping interest '" << dataName
+                                            << "' - SCHEMA version=" << m_schemaPublisher.getVersion());
+          return;
+        }
+        sendData(segment);
         return;
       }
     }
 
-    void CustomTrustAnchor::OnDataCertificate(std::shared_ptr<const ndn::Data> data) {
+    void CustomTrustAnchor::OnDataCertificate(std::shared_ptr<const ndn::Data> data,
+                                              const ValidationContext &ctx) {
       NS_LOG_FUNCTION(data->getName());
-      CustomApp::OnDataCertificate(data);
+      CustomApp::OnDataCertificate(data, ctx);
 
       // get keyname and buffer info
       auto keyName = ::ndn::security::v2::extractKeyNameFromCertName(data->getName());
       auto identityName = ::ndn::security::v2::extractIdentityFromKeyName(keyName);
+      auto it = m_signRequests.find(keyName);
+      if(it == m_signRequests.end() || !it->second.inService) {
+        NS_LOG_INFO("Dropping CERTIFICATE '" << data->getName() << "' - no SIGN request in service");
+        return;
+      }
 
-      // Change certificate signing name to /<prefix>/KEY/keyID/signerID/versionID
-      auto rand = CreateObject<::ns3::UniformRandomVariable>();
-      auto cert = std::make_shared<::ndn::Data>(*data);
+      // certificate /<prefix>/KEY/keyID/signerID/versionID and SIGN Data (its content is the certificate)
       auto signerID = std::to_string((uint32_t)GetNode()->GetId());
-      auto versionID = std::to_string((uint32_t)rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-      cert->setName(keyName.deepCopy().append(signerID).append(versionID));
-
-      // sign certificate with default identity
-      m_keyChain.sign(*cert, m_signingInfo);
-
-      // create SIGN Data packet
-      auto signCertPrefix = std::make_shared<::ndn::Name>(m_signPrefix.deepCopy().append(data->getName()));
-      auto newData = std::make_shared<::ndn::Data>();
-      newData->setName(*signCertPrefix);
-      newData->setFreshnessPeriod(::ndn::time::milliseconds(1));
-      newData->setContent(cert->wireEncode());
-
-      // Sign Data with default identity, send packet
-      m_keyChain.sign(*newData, m_signingInfo);
-      sendData(newData);
-
-      // updateSchema
-      addProducerSchema(identityName);
+      auto issuance = CustomCertificateIssuer::prepare(*data, ::ndn::name::Component(signerID), m_signPrefix,
+                                                       getValidityFreshness());
+      auto cert = issuance.certificate;
+      auto newData = issuance.response;
+
+      // sign certificate, then SIGN Data, with default identity in one crypto pool job, send packet
+      auto onSigned = [this, cert, newData, keyName, identityName] {
+        m_issuedCertificates.erase(keyName);
+        m_issuedCertificates.emplace(keyName, ::ndn::security::v2::Certificate(*cert));
+        m_signResponses[keyName] = newData;
+        sendData(newData);
+        finishSignRequest(keyName, true);
+        m_certificateIssued(this, cert->getName());
+        logEvent(CustomEventLog::CERT_ISSUED);
+
+        // updateSchema (also on the other trust anchors of the zone)
+        addProducerSchema(identityName);
+        sendSchemaSync(identityName);
+      };
+      signAsync({cert, newData}, m_signingInfo, onSigned, [issuance](size_t i) {
+        if(i == 1) {
+          CustomCertificateIssuer::setCertificate(issuance);
+        }
+      });
     }
 
-    void CustomTrustAnchor::OnDataContent(std::shared_ptr<const ndn::Data> data) {
+    void CustomTrustAnchor::OnDataContent(std::shared_ptr<const ndn::Data> data,
+                                          const ValidationContext &ctx) {
       NS_LOG_FUNCTION(data->getName());
-      CustomApp::OnDataContent(data);
+      CustomApp::OnDataContent(data, ctx);
+      if(m_schemaSyncPrefix.isPrefixOf(data->getName())) {
+        OnDataSchemaSync(data);
+      }
+    }
+
+    /// @brief zone KEY, served SCHEMA and issued certificates (SIGN responses)
+    void CustomTrustAnchor::writeSnapshot(CustomSnapshot &snapshot) {
+      CustomApp::writeSnapshot(snapshot);
+      // the version served to validators, as built (a pending SchemaUpdateDelay update is left out)
+      CustomSnapshot::Schema schema;
+      schema.version = m_schemaPublisher.getVersion();
+      schema.payload = m_schemaPublisher.getPayload();
+      snapshot.setSchema(m_schemaContentPrefix, schema);
+      for(const auto &pairKeyData : m_signResponses) {
+        snapshot.addSignResponse(m_zonePrefix, *pairKeyData.second);
+      }
     }
 
     //////////////////////
@@ -180,53 +285,358 @@ namespace ns3 {
     //////////////////////
 
     void CustomTrustAnchor::createTrustAnchor() {
-      // declare regexes
-      std::string dataRegex, keyLocatorRegex;
-
       // create TRUST ANCHOR file
       NS_LOG_INFO("Creating Trust Anchor .cert file for '" << m_zonePrefix << "' zone ...");
-      ::ndn::io::save(createCertificate(m_zonePrefix), m_trustAnchorCert);
+      CustomSchemaStore::getInstance().writeCertificate(m_trustAnchorCert, createZoneCertificate());
       addTrustAnchor(m_trustAnchorCert);
 
+      // add hierarchical rules first, so SIGN/SCHEMA rules take precedence over them
+      if(m_schemaMode == "hierarchical") {
+        addHierarchicalSchema();
+      } else if(m_schemaMode != "explicit") {
+        throw std::runtime_error("Unknown SchemaMode '" + m_schemaMode + "'");
+      }
+
       // add SIGN protocols
-      dataRegex = "^" + getValidationRegex(m_signPrefix) + "<>*$";
-      keyLocatorRegex = "^" + getValidationRegex(m_zonePrefix) + "<KEY><>{1,3}$";
-      addValidationRule(dataRegex, keyLocatorRegex);
+      addValidationRule(CustomSchemaRules::createZoneRule(m_signPrefix, m_zonePrefix));
 
       // add SCHEMA protocols
-      dataRegex = "^" + getValidationRegex(m_schemaPrefix) + "<>*$";
-      keyLocatorRegex = "^" + getValidationRegex(m_zonePrefix) + "<KEY><>{1,3}$";
-      addValidationRule(dataRegex, keyLocatorRegex);
+      addValidationRule(CustomSchemaRules::createZoneRule(m_schemaPrefix, m_zonePrefix));
+
+      // add GROUPKEY protocols
+      if(m_useGroupKey) {
+        createGroupKey();
+        addValidationRule(CustomSchemaRules::createZoneRule(m_groupKeyPrefix, m_zonePrefix));
+      }
+    }
+
+    /// @brief warm start: SCHEMA, enrolled producers and issued certificates of the loaded snapshot
+    void CustomTrustAnchor::restoreTrustAnchor() {
+      auto &snapshot = CustomSnapshot::getInstance();
+      if(!restoreValidationRules()) {
+        return;
+      }
+      // same payload and enrolled set, so updateSchemaSegments() derives the version validators restored
+      for(const auto &signResponse : snapshot.getSignResponses(m_zonePrefix)) {
+        ::ndn::security::v2::Certificate cert(signResponse->getContent().blockFromValue());
+        auto keyName = cert.getKeyName();
+        m_enrolledIdentities.insert(cert.getIdentity());
+        if(m_membership != nullptr) {
+          m_membership->insert(cert.getIdentity());
+        }
+        if(isResponsibleFor(keyName)) {
+          m_issuedCertificates.erase(keyName);
+          m_issuedCertificates.emplace(keyName, cert);
+          m_signResponses[keyName] = std::make_shared<::ndn::Data>(*signResponse);
+        }
+      }
+      NS_LOG_INFO("Restored " << m_enrolledIdentities.size() << " enrolled identities from snapshot");
+    }
+
+    /// @brief fixed rules for any identity under the zone, whatever the number of producers
+    void CustomTrustAnchor::addHierarchicalSchema() {
+      NS_LOG_FUNCTION(m_zonePrefix);
+      auto zoneRegex = CustomSchemaRules::getValidationRegex(m_zonePrefix);
+      m_membership = std::make_shared<CustomMembershipSet>(CustomMembershipSet::parseType(m_membershipType),
+                                                           m_membershipBloomBits);
+      m_membership->setZone(m_zonePrefix);
+      setValidationSection("membership", m_membership->toConfigSection());
+
+      // any APP data under the zone, signed by the KEY of an enrolled identity that prefixes the data name
+      ::ndn::security::v2::validator_config::ConfigSection appRule;
+      appRule.put("id", "^" + zoneRegex + "<>+$");
+      appRule.put("for", "data");
+      appRule.put("filter.type", "name");
+      appRule.put("filter.regex", "^" + zoneRegex + "<>+$");
+      appRule.put("checker.type", "customized");
+      appRule.put("checker.sig-type", "rsa-sha256");
+      appRule.put("checker.key-locator.type", "name");
+      appRule.put("checker.key-locator.enrolled", "true");
+      appRule.put("checker.key-locator.hyper-relation.k-regex", "^(<>*)<KEY><>{1,3}$");
+      appRule.put("checker.key-locator.hyper-relation.k-expand", "\\1");
+      appRule.put("checker.key-locator.hyper-relation.h-relation", "is-prefix-of");
+      appRule.put("checker.key-locator.hyper-relation.p-regex", "^(<>*)$");
+      appRule.put("checker.key-locator.hyper-relation.p-expand", "\\1");
+      addGroupKeyChecker(appRule);
+      addValidationRule(appRule);
+
+      // any identity KEY under the zone, signed by the zone KEY (takes precedence over the APP rule)
+      addValidationRule("^" + zoneRegex + "<>+<KEY><>{1,3}$", "^" + zoneRegex + "<KEY><>{1,3}$");
     }
 
     void CustomTrustAnchor::addProducerSchema(const ::ndn::Name &identityName) {
-      // declare regexes
-      std::string dataRegex, keyLocatorRegex;
+      if(!m_enrolledIdentities.insert(identityName).second) {
+        NS_LOG_INFO("Identity '" << identityName << "' already in the trust schema");
+        return;
+      }
 
-      // add Producer KEY signing verification
+      if(m_schemaMode == "hierarchical") {
+        // rules are fixed, only track the enrolled identity
+        NS_LOG_FUNCTION("Identity = " << identityName);
+        m_membership->insert(identityName);
+        setValidationSection("membership", m_membership->toConfigSection());
+        scheduleSchemaUpdate();
+        return;
+      }
+
+      // producer rules (APP, KEY) come first, in descending name order of the enrolled identities: the
+      // same schema on every trust anchor whatever the enrollment order, and nested identities first
       NS_LOG_FUNCTION("Identity = " << identityName);
-      dataRegex = "^" + getValidationRegex(identityName) + "<KEY><>{1,3}$";
-      keyLocatorRegex = "^" + getValidationRegex(m_zonePrefix) + "<KEY><>{1,3}$";
-      addValidationRule(dataRegex, keyLocatorRegex);
+      size_t position = 2 * std::distance(m_enrolledIdentities.upper_bound(identityName),
+                                          m_enrolledIdentities.end());
 
-      // add Producer APP signing verification
-      dataRegex = "^" + getValidationRegex(identityName) + "[^<KEY>]*$";
-      keyLocatorRegex = "^" + getValidationRegex(identityName) + "<KEY><>{1,3}$";
-      addValidationRule(dataRegex, keyLocatorRegex);
+      // add Producer KEY signing verification
+      insertValidationRule(position, CustomSchemaRules::createProducerKeyRule(identityName, m_zonePrefix));
+
+      // add Producer APP signing verification (producer KEY or zone group key)
+      auto appRule = CustomSchemaRules::createProducerAppRule(identityName);
+      addGroupKeyChecker(appRule);
+      insertValidationRule(position, appRule);
 
       // inform the network about the changes in the schema
-      sendDataSubscribe();
+      scheduleSchemaUpdate();
+    }
+
+    /// @brief content Data may also be signed with the zone group key (HMAC)
+    void CustomTrustAnchor::addGroupKeyChecker(::ndn::security::v2::validator_config::ConfigSection &rule) {
+      if(!m_useGroupKey) {
+        return;
+      }
+      ::ndn::security::v2::validator_config::ConfigSection checker;
+      checker.put("type", "customized");
+      checker.put("sig-type", "hmac-sha256");
+      checker.put("key-locator.type", "name");
+      checker.put("key-locator.regex", "^" + CustomSchemaRules::getValidationRegex(m_groupKeyPrefix) + "<>$");
+      rule.add_child("checker", checker);
+    }
+
+    /// @brief the group key is created by the first trust anchor of the zone and shared with the others
+    void CustomTrustAnchor::createGroupKey() {
+      auto &store = CustomSchemaStore::getInstance();
+      m_groupKeyName = m_groupKeyPrefix.deepCopy().appendVersion(1);
+      m_groupKey = store.readGroupKey(m_groupKeyName);
+      if(m_groupKey == nullptr) {
+        NS_LOG_INFO("Creating group KEY '" << m_groupKeyName << "' ...");
+        m_groupKey = CustomGroupKey::generateKey();
+        chargeEnergy(CustomCryptoEnergyModel::KEYGEN, ::ndn::tlv::SignatureHmacWithSha256);
+        store.writeGroupKey(m_groupKeyName, m_groupKey);
+      }
+    }
+
+    /// @brief reply /<zone>/GROUPKEY/<producer KEY> with the group key encrypted to the producer KEY
+    void CustomTrustAnchor::sendGroupKey(std::shared_ptr<const ndn::Interest> interest) {
+      auto &dataName = interest->getName();
+      auto keyName = dataName.getSubName(m_groupKeyPrefix.size());
+      if(m_groupKey == nullptr) {
+        return;
+      } else if(!isResponsibleFor(keyName)) {
+        NS_LOG_INFO("GROUPKEY request for '" << keyName << "' is served by another trust anchor");
+        return;
+      }
+      auto it = m_issuedCertificates.find(keyName);
+      if(it == m_issuedCertificates.end()) {
+        NS_LOG_INFO("Dropping GROUPKEY request for '" << keyName << "' - KEY not enrolled");
+        return;
+      }
+      auto data = std::make_shared<::ndn::Data>(dataName);
+      data->setFreshnessPeriod(::ndn::time::milliseconds(1));
+      try {
+        data->setContent(CustomGroupKey::encryptKey(m_groupKeyName, *m_groupKey, it->second));
+      } catch(const std::exception &e) {
+        NS_LOG_WARN("Failed to encrypt group KEY for '" << keyName << "' - Error=" << e.what());
+        return;
+      }
+      NS_LOG_INFO("Sending GROUPKEY '" << m_groupKeyName << "' to '" << keyName << "' ...");
+      signAsync(data, m_signingInfo, [this, data] { sendData(data); });
+    }
+
+    /// @brief split the current SCHEMA into segments (new version only if the payload has changed)
+    void CustomTrustAnchor::updateSchemaSegments() {
+      ::ndn::Buffer payload;
+      if(m_schemaFormat == "tlv") {
+        auto block = getValidationRulesBlock();
+        payload.assign(block.wire(), block.wire() + block.size());
+      } else if(m_schemaFormat == "info") {
+        auto schemaRules = getValidationRules();
+        payload.assign(schemaRules.begin(), schemaRules.end());
+      } else {
+        throw std::runtime_error("Unknown SchemaFormat '" + m_schemaFormat + "'");
+      }
+      m_schemaDirty = false;
+      // segments stay valid as long as the zone KEY signatures, manifest with default identity
+      m_schemaPublisher.setFreshness(getValidityFreshness(),
+                                     ::ndn::time::milliseconds(m_schemaFreshness.GetMilliSeconds()));
+      auto signSchema = [this](::ndn::Data &data, const ::ndn::security::SigningInfo &signingInfo) {
+        sign(data, signingInfo);
+      };
+      // same enrolled set and payload => same version on every trust anchor of the zone
+      auto enrolled = m_enrolledIdentities.size();
+      if(!m_schemaPublisher.update(std::move(payload), enrolled, m_signingInfo, signSchema)) {
+        return;
+      }
+      auto version = m_schemaPublisher.getVersion();
+      NS_LOG_INFO("SCHEMA version=" << version << " - " << m_schemaPublisher.getPayload().size()
+                                    << " bytes in " << m_schemaPublisher.getSegmentCount() << " segments");
+      logEvent(CustomEventLog::SCHEMA_UPDATE, version);
+    }
+
+    /// @brief the zone KEY is created by the first trust anchor of the zone and shared with the others
+    const ::ndn::security::v2::Certificate &CustomTrustAnchor::createZoneCertificate() {
+      // out-of-band distribution of the zone KEY among the trust anchors of the zone (same simulation)
+      static std::map<::ndn::Name, std::shared_ptr<::ndn::security::SafeBag>> zoneKeys;
+      static const std::string password = "zone-key";
+      std::lock_guard<std::recursive_mutex> lock(m_keyChainMutex);
+
+      auto it = zoneKeys.find(m_zonePrefix);
+      if(it == zoneKeys.end()) {
+        auto &cert = createCertificate(m_zonePrefix);
+        zoneKeys[m_zonePrefix] = m_keyChain.exportSafeBag(cert, password.c_str(), password.size());
+        return cert;
+      }
+      NS_LOG_INFO("Importing zone KEY of '" << m_zonePrefix << "' ...");
+      try {
+        m_keyChain.deleteIdentity(m_keyChain.getPib().getIdentity(m_zonePrefix));
+      } catch(::ndn::security::pib::Pib::Error &e) {
+        // no identity found, proceed with the import
+      }
+      m_keyChain.importSafeBag(*it->second, password.c_str(), password.size());
+      return m_keyChain.getPib().getIdentity(m_zonePrefix).getDefaultKey().getDefaultCertificate();
+    }
+
+    bool CustomTrustAnchor::isResponsibleFor(const ::ndn::Name &keyName) {
+      return (utils::fnv1a(keyName.toUri()) % m_anchorCount == m_anchorIndex);
+    }
+
+    /// @brief tell the other trust anchors of the zone about a new enrollment (signed with the zone KEY),
+    ///        sent again every SchemaSyncRetry until acknowledged
+    void CustomTrustAnchor::sendSchemaSync(const ::ndn::Name &identityName) {
+      if(m_anchorCount <= 1) {
+        return;
+      }
+      auto syncName = m_schemaSyncPrefix.deepCopy().append(identityName);
+      auto interest = std::make_shared<::ndn::Interest>(syncName);
+      interest->setCanBePrefix(false);
+      interest->setInterestLifetime(ndn::time::milliseconds(m_schemaSyncRetry.GetMilliSeconds()));
+      sign(*interest, m_signingInfo);
+      sendInterest(interest);
+      m_sendEvents[syncName.toUri()] =
+          Simulator::Schedule(m_schemaSyncRetry, &CustomTrustAnchor::sendSchemaSync, this, identityName);
+    }
+
+    /// @brief ack of a SCHEMA sync (signed by the zone KEY): stop sending it
+    void CustomTrustAnchor::OnDataSchemaSync(std::shared_ptr<const ndn::Data> data) {
+      auto &name = data->getName();
+      if(name.size() < m_schemaSyncPrefix.size() + ::ndn::signed_interest::MIN_SIZE) {
+        return;
+      }
+      std::unique_lock<std::recursive_mutex> lock(m_keyChainMutex);
+      auto start = std::chrono::steady_clock::now();
+      bool isSigned = ::ndn::security::verifySignature(
+          *data, m_keyChain.getPib().getIdentity(m_zonePrefix).getDefaultKey());
+      traceCryptoTime(start);
+      lock.unlock();
+      chargeCpu(CustomCpuModel::VERIFY, data->getSignature().getType());
+      if(!isSigned) {
+        NS_LOG_INFO("Dropping SCHEMA sync ack '" << name << "' - not signed by the zone KEY");
+        return;
+      }
+      auto syncName = name.getPrefix(-static_cast<ssize_t>(::ndn::signed_interest::MIN_SIZE));
+      auto it = m_sendEvents.find(syncName.toUri());
+      if(it != m_sendEvents.end()) {
+        NS_LOG_INFO("SCHEMA sync '" << syncName << "' acknowledged");
+        Simulator::Cancel(it->second);
+        m_sendEvents.erase(it);
+      }
+    }
+
+    void CustomTrustAnchor::OnInterestSchemaSync(std::shared_ptr<const ndn::Interest> interest) {
+      auto &name = interest->getName();
+      std::unique_lock<std::recursive_mutex> lock(m_keyChainMutex);
+      auto start = std::chrono::steady_clock::now();
+      bool isSigned = (name.size() >= m_schemaSyncPrefix.size() + ::ndn::signed_interest::MIN_SIZE &&
+                       ::ndn::security::verifySignature(
+                           *interest, m_keyChain.getPib().getIdentity(m_zonePrefix).getDefaultKey()));
+      traceCryptoTime(start);
+      lock.unlock();
+      chargeCpu(CustomCpuModel::VERIFY, getSignatureType(*interest));
+      if(!isSigned) {
+        NS_LOG_INFO("Dropping SCHEMA sync '" << name << "' - not signed by the zone KEY");
+        return;
+      }
+      auto identityName = name.getSubName(m_schemaSyncPrefix.size(), name.size() - m_schemaSyncPrefix.size() -
+                                                                          ::ndn::signed_interest::MIN_SIZE);
+      NS_LOG_INFO("SCHEMA sync for identity '" << identityName << "'");
+      addProducerSchema(identityName);
+
+      // acknowledge, so the Interest does not linger in the PITs
+      auto data = std::make_shared<::ndn::Data>(name);
+      data->setFreshnessPeriod(::ndn::time::milliseconds(1));
+      sign(*data, m_signingInfo);
+      sendData(data);
+    }
+
+    /// @brief take a slot and request the producer KEY
+    void CustomTrustAnchor::startSignRequest(const ::ndn::Name &keyName) {
+      auto &request = m_signRequests[keyName];
+      request.inService = true;
+      request.timeout = Simulator::Schedule(m_signServiceTimeout, &CustomTrustAnchor::finishSignRequest, this,
+                                            keyName, false);
+      m_signInService++;
+
+      NS_LOG_INFO("Sending KEY request for '" << keyName << "' ...");
+      InterestOptions opts;
+      opts.canBePrefix = true;
+      opts.mustBeFresh = true;
+      sendInterest(keyName, m_signLifetime, opts);
+    }
+
+    /// @brief release the slot of a SIGN request (signed or timed out) and serve the next queued one
+    void CustomTrustAnchor::finishSignRequest(const ::ndn::Name &keyName, bool completed) {
+      auto it = m_signRequests.find(keyName);
+      if(it == m_signRequests.end()) {
+        return;
+      }
+      Simulator::Cancel(it->second.timeout);
+      if(completed) {
+        m_signServiceTime(this, Simulator::Now() - it->second.arrival);
+      } else {
+        NS_LOG_INFO("SIGN request for '" << keyName << "' timed out");
+      }
+      m_signRequests.erase(it);
+      m_signInService--;
+
+      if(!m_signQueue.empty()) {
+        auto nextKeyName = m_signQueue.front();
+        m_signQueue.pop_front();
+        m_signQueueDepth = m_signQueue.size();
+        startSignRequest(nextKeyName);
+      }
+    }
+
+    /// @brief new SCHEMA version after SchemaUpdateDelay: the enrollments until then are encoded (and
+    ///        announced) once, instead of once per enrollment
+    void CustomTrustAnchor::scheduleSchemaUpdate() {
+      m_schemaDirty = true;
+      if(!m_schemaUpdateEvent.IsRunning()) {
+        m_schemaUpdateEvent =
+            Simulator::Schedule(m_schemaUpdateDelay, &CustomTrustAnchor::sendDataSubscribe, this);
+      }
     }
 
     // reply with SCHEMA/SUBCRIBE
     void CustomTrustAnchor::sendDataSubscribe() {
+      // announce the new version, so validators that get an older (cached) manifest ask again
+      if(m_schemaDirty) {
+        updateSchemaSegments();
+      }
       auto data = std::make_shared<::ndn::Data>();
       data->setName(m_schemaSubscribePrefix);
-      data->setFreshnessPeriod(::ndn::time::milliseconds(1));
-      data->setContent(std::make_shared<::ndn::Buffer>());
+      data->setFreshnessPeriod(::ndn::time::milliseconds(1)); // notification, not to be answered by caches
+      data->setContent(::ndn::encoding::makeNonNegativeIntegerBlock(CustomSchemaTlv::Version,
+                                                                    m_schemaPublisher.getVersion()));
 
       // Sign Data with default identity, send packet
-      m_keyChain.sign(*data, m_signingInfo);
+      sign(*data, m_signingInfo);
       sendData(data);
     }
 
@@ -3,7 +3,13 @@
 #ifndef CUSTOM_TRUST_ANCHOR_H_
 #define CUSTOM_TRUST_ANCHOR_H_
 
+// NS3 / NDNSIM
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+
 // system libs
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -13,6 +19,9 @@
 
 // custom includes
 #include "custom-app.hpp"
+#include "custom-certificate-issuer.hpp"
+#include "custom-membership.hpp"
+#include "custom-schema-publisher.hpp"
 
 // namespace ns3 {
 //     class IntMetricSet : public std::set<IntMetric> {};
@@ -36,6 +45,12 @@ namespace ns3 {
 
     class CustomTrustAnchor : public CustomApp {
 
+    public:
+      /// @brief SIGN request completed (trust anchor app, time from SIGN Interest to signed certificate)
+      typedef void (*SignServiceTimeCallback)(Ptr<App> app, Time serviceTime);
+      /// @brief producer certificate signed and sent (trust anchor app, certificate name)
+      typedef void (*CertificateIssuedCallback)(Ptr<App> app, const ::ndn::Name &certName);
+
     public:
       static TypeId GetTypeId();
       CustomTrustAnchor();
@@ -47,24 +62,83 @@ namespace ns3 {
       void OnInterestKey(std::shared_ptr<const ndn::Interest> interest) override;
       void OnInterestContent(std::shared_ptr<const ndn::Interest> interest) override;
 
-      void OnDataCertificate(std::shared_ptr<const ndn::Data> data) override;
-      void OnDataContent(std::shared_ptr<const ndn::Data> data) override;
+      void OnDataCertificate(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) override;
+      void OnDataContent(std::shared_ptr<const ndn::Data> data, const ValidationContext &ctx) override;
+
+      void writeSnapshot(CustomSnapshot &snapshot) override;
 
     private:
       void createTrustAnchor();
+      void restoreTrustAnchor();
+      const ::ndn::security::v2::Certificate &createZoneCertificate();
       void readValidationRules();
 
       void addProducerSchema(const ::ndn::Name &identityName);
+      void addHierarchicalSchema();
+      void addGroupKeyChecker(::ndn::security::v2::validator_config::ConfigSection &rule);
 
+      void createGroupKey();
+      void sendGroupKey(std::shared_ptr<const ndn::Interest> interest);
+
+      void scheduleSchemaUpdate();
       void sendDataSubscribe();
+      void updateSchemaSegments();
+
+      bool isResponsibleFor(const ::ndn::Name &keyName);
+      void sendSchemaSync(const ::ndn::Name &identityName);
+      void OnInterestSchemaSync(std::shared_ptr<const ndn::Interest> interest);
+      void OnDataSchemaSync(std::shared_ptr<const ndn::Data> data);
+
+      void startSignRequest(const ::ndn::Name &keyName);
+      void finishSignRequest(const ::ndn::Name &keyName, bool completed);
+
+    private:
+      struct SignRequest {
+        Time arrival;    ///< @brief first SIGN Interest received
+        EventId timeout; ///< @brief releases the slot if the producer KEY never arrives (in service only)
+        bool inService;
+      };
 
     private:
       ::ndn::Name m_zonePrefix;
       ::ndn::Name m_zoneKeyPrefix;
 
-      // ns3::Time m_schemaFreshness;
+      ns3::Time m_schemaFreshness; ///< @brief freshness of the SCHEMA manifest
+
+      std::string m_schemaFormat; ///< @brief SCHEMA/CONTENT payload encoding: tlv or info
+      uint32_t m_schemaSegmentSize; ///< @brief max payload bytes per SCHEMA segment
+
+      CustomSchemaPublisher m_schemaPublisher; ///< @brief served SCHEMA version: manifest and segments
+      bool m_schemaDirty;          ///< @brief rules changed since the served SCHEMA version was built
+      Time m_schemaUpdateDelay;    ///< @brief rule changes within this time share one new SCHEMA version
+      EventId m_schemaUpdateEvent; ///< @brief pending SCHEMA update (sendDataSubscribe)
+
+      std::string m_schemaMode; ///< @brief explicit (2 rules per producer) or hierarchical (fixed rules)
+      std::string m_membershipType;
+      uint32_t m_membershipBloomBits;
+      std::shared_ptr<CustomMembershipSet> m_membership; ///< @brief enrolled identities (hierarchical)
+      std::set<::ndn::Name> m_enrolledIdentities;
+      /// @brief certificates issued by this trust anchor, by KEY name (the group key is encrypted to them)
+      std::map<::ndn::Name, ::ndn::security::v2::Certificate> m_issuedCertificates;
+      std::map<::ndn::Name, std::shared_ptr<::ndn::Data>> m_signResponses; ///< @brief SIGN Data, by KEY name
+
+      uint32_t m_anchorIndex; ///< @brief serves the SIGN requests with fnv1a(KEY name) % AnchorCount == index
+      uint32_t m_anchorCount; ///< @brief trust anchors sharing the zone KEY
+      ::ndn::Name m_schemaSyncPrefix; ///< @brief /<zone>/SCHEMA/SYNC/<identity> (enrolled by other anchor)
+      Time m_schemaSyncRetry;         ///< @brief SCHEMA sync sent again until acknowledged
 
       std::string m_trustAnchorCert;
+
+      uint32_t m_maxConcurrentSign; ///< @brief SIGN requests served at the same time
+      uint32_t m_maxSignQueue;      ///< @brief SIGN requests waiting for a slot (more are Nacked)
+      Time m_signServiceTimeout;
+      std::map<::ndn::Name, SignRequest> m_signRequests; ///< @brief queued + in service, by KEY name
+      std::deque<::ndn::Name> m_signQueue;
+      uint32_t m_signInService;
+
+      TracedValue<uint32_t> m_signQueueDepth;
+      TracedCallback<Ptr<App>, Time> m_signServiceTime;
+      TracedCallback<Ptr<App>, const ::ndn::Name &> m_certificateIssued;
     };
 
   } // namespace ndn
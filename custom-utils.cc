@@ -2,6 +2,9 @@
 
 #include "custom-utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace utils {
 
   AvgStruct::AvgStruct() { this->clear(); }
@@ -18,6 +21,29 @@ namespace utils {
 
   double AvgStruct::get() { return m_data; }
 
+  ZipfMandelbrot::ZipfMandelbrot(uint64_t n, double alpha, double q) {
+    if(n == 0) {
+      throw std::invalid_argument("Zipf-Mandelbrot catalog must have at least 1 item");
+    }
+    // normalized once, draws only search the CDF
+    m_cdf.resize(n);
+    double sum = 0;
+    for(uint64_t k = 1; k <= n; k++) {
+      sum += 1.0 / std::pow(k + q, alpha);
+      m_cdf[k - 1] = sum;
+    }
+    for(auto &value : m_cdf) {
+      value /= sum;
+    }
+    m_cdf.back() = 1.0;
+  }
+
+  uint64_t ZipfMandelbrot::getRank(double u) const {
+    return std::upper_bound(m_cdf.begin(), m_cdf.end(), u) - m_cdf.begin() + 1;
+  }
+
+  uint64_t ZipfMandelbrot::size() const { return m_cdf.size(); }
+
   bool fileExists(std::string filename) {
     std::ifstream is(filename);
     return is.good();
@@ -49,4 +75,13 @@ namespace utils {
     return items;
   }
 
+  uint64_t fnv1a(const std::string &str, uint64_t seed) {
+    uint64_t h = 14695981039346656037ULL ^ seed;
+    for(auto c : str) {
+      h ^= static_cast<uint8_t>(c);
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
 } // namespace utils
\ No newline at end of file
@@ -25,6 +25,18 @@ namespace utils {
     uint64_t m_count;
   };
 
+  /// @brief Zipf-Mandelbrot distribution over ranks 1..n, p(k) ~ 1 / (k + q)^alpha
+  class ZipfMandelbrot {
+  public:
+    ZipfMandelbrot(uint64_t n = 1, double alpha = 1.0, double q = 0.0);
+    /// @brief rank of a uniform value u in [0, 1) (binary search over the precomputed CDF)
+    uint64_t getRank(double u) const;
+    uint64_t size() const;
+
+  private:
+    std::vector<double> m_cdf;
+  };
+
   bool fileExists(std::string filename);
 
   int generateRandomInteger(int min = std::numeric_limits<int>::min(),
@@ -32,6 +44,9 @@ namespace utils {
 
   std::shared_ptr<std::vector<std::string>> splitStringByDelimiter(const std::string &str, char delimiter);
 
+  /// @brief FNV-1a (stable across platforms and standard libraries, unlike std::hash)
+  uint64_t fnv1a(const std::string &str, uint64_t seed = 0);
+
 } // namespace utils
 
 #endif /* CUSTOM_UTILS_H */
\ No newline at end of file
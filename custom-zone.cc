@@ -8,15 +8,18 @@ using namespace std;
 namespace ns3 {
   namespace ndn {
 
-    CustomZone::CustomZone(string zoneName)
+    CustomZone::CustomZone(string zoneName, int n_TrustAnchors)
         : m_zoneName(zoneName), m_schemaPrefix(m_zoneName + "/SCHEMA"), m_signPrefix(m_zoneName + "/SIGN"),
+          m_groupKeyPrefix(m_zoneName + "/GROUPKEY"),
           m_trustAnchorCert("/ndnSIM/ns-3/scratch/sim_bootsec/config" + m_zoneName + "_trustanchor.cert"),
           m_validatorConf("/ndnSIM/ns-3/scratch/sim_bootsec/config" + m_zoneName + "_validator.conf"),
+          m_contentZoneName(m_zoneName), m_contentZone(this), m_trustedZones(""),
           m_consumers(make_shared<NodeContainer>()), m_producers(make_shared<NodeContainer>()),
           m_trust_anchors(make_shared<NodeContainer>()) {
-      addTrustAnchor();
+      addTrustAnchors(n_TrustAnchors);
     }
-    CustomZone::CustomZone(string zoneName, int n_Producers, int n_Consumers) : CustomZone(zoneName) {
+    CustomZone::CustomZone(string zoneName, int n_Producers, int n_Consumers, int n_TrustAnchors)
+        : CustomZone(zoneName, n_TrustAnchors) {
       addProducers(n_Producers);
       addConsumers(n_Consumers);
     }
@@ -27,30 +30,83 @@ namespace ns3 {
     shared_ptr<NodeContainer> CustomZone::getProducers() { return m_producers; }
     shared_ptr<NodeContainer> CustomZone::getConsumers() { return m_consumers; }
 
+    string CustomZone::getZoneName() { return m_zoneName; }
+    string CustomZone::getValidatorConf() { return m_validatorConf; }
+
+    void CustomZone::setContentZone(shared_ptr<CustomZone> zone) {
+      m_contentZoneName = zone->getZoneName();
+      m_contentZone = zone.get();
+      m_trustedZones = "";
+      if(m_contentZoneName != m_zoneName) {
+        // --> ASSUMPTION 01 (cross-zone): foreign SCHEMA / trust anchor .CERT out-of-band distribution
+        m_trustedZones = m_contentZoneName + "=" + zone->getValidatorConf();
+      }
+    }
+
     void CustomZone::addConsumers(int n) { m_consumers->Create(n); }
     void CustomZone::addProducers(int n) { m_producers->Create(n); }
 
+    const CustomZone::Workload &CustomZone::getWorkload() { return m_workload; }
+    void CustomZone::setWorkload(const Workload &workload) {
+      if(workload.prefixes.empty()) {
+        throw std::runtime_error("Failed to set workload of zone '" + m_zoneName + "' - Error=no prefixes");
+      }
+      for(size_t i = 0; i + 1 < workload.prefixes.size(); i++) {
+        if(workload.prefixes[i].producers == 0) {
+          // "all remaining producers" would leave none for the next prefixes
+          throw std::runtime_error("Failed to set workload of zone '" + m_zoneName + "' - Error=prefix '" +
+                                   workload.prefixes[i].prefix + "' has 0 producers (only allowed on the " +
+                                   "last prefix)");
+        }
+      }
+      m_workload = workload;
+    }
+
     void CustomZone::installAllTrustAnchorApps() {
       // create TRUST ANCHOR and SCHEMA for zone
       installTrustAnchorApp(2.0);
     }
     void CustomZone::installAllProducerApps() {
-      // create PRODUCER for prefix "/test/prefix"
-      installProducerApp("/test/prefix", 2.0, "1480");
+      // create PRODUCERS for each prefix of the workload (producers assigned in order)
+      uint32_t next = 0;
+      for(const auto &spec : m_workload.prefixes) {
+        auto n = (spec.producers == 0 ? m_producers->GetN() - next : spec.producers);
+        if(next + n > m_producers->GetN()) {
+          throw std::runtime_error("Failed to install producers for prefix='" + spec.prefix +
+                                   "' - Error=zone '" + m_zoneName + "' has only " +
+                                   std::to_string(m_producers->GetN()) + " producers");
+        }
+        NodeContainer producers;
+        for(uint32_t i = 0; i < n; i++) {
+          producers.Add(m_producers->Get(next++));
+        }
+        installProducerApp(producers, spec.prefix, spec.freshness, std::to_string(spec.payloadSize));
+      }
     }
     void CustomZone::installAllConsumerApps() {
-      // create CONSUMER for prefix "/test/prefix"
-      installConsumerApp("/test/prefix", "1s", 10, "uniform");
+      // create CONSUMERS for the prefixes of the content zone, picked by (Zipf) popularity, with the
+      // request rate and lifetime of the content zone workload
+      const auto &workload = m_contentZone->getWorkload();
+      Ptr<ZipfRandomVariable> popularity = CreateObject<ZipfRandomVariable>();
+      popularity->SetAttribute("N", IntegerValue(workload.prefixes.size()));
+      popularity->SetAttribute("Alpha", DoubleValue(workload.zipfAlpha));
+      Ptr<UniformRandomVariable> rate = CreateObject<UniformRandomVariable>();
+      for(auto &consumer : *m_consumers) {
+        const auto &spec = workload.prefixes[popularity->GetInteger() - 1];
+        installConsumerApp(consumer, spec.prefix, workload.lifetime,
+                           rate->GetValue(workload.rateMin, workload.rateMax), workload.randomize, workload);
+      }
     }
 
     //////////////////////
     //     PRIVATE
     //////////////////////
 
-    void CustomZone::addTrustAnchor() { m_trust_anchors->Create(1); }
+    void CustomZone::addTrustAnchors(int n) { m_trust_anchors->Create(n); }
 
-    void CustomZone::installConsumerApp(string prefix, string lifetime, double pktFreq, string randomize) {
-      auto prefixApp = m_zoneName + prefix;
+    void CustomZone::installConsumerApp(Ptr<Node> consumer, string prefix, string lifetime, double pktFreq,
+                                        string randomize, const Workload &catalog) {
+      auto prefixApp = m_contentZoneName + prefix;
       NS_LOG_INFO("Installing Consumer App for '" << prefixApp << "' ...");
       // ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
       ndn::AppHelper consumerHelper("CustomConsumer");
@@ -60,19 +116,23 @@ namespace ns3 {
       consumerHelper.SetAttribute("LifeTime", StringValue(lifetime));
       // consumer randomize send time
       consumerHelper.SetAttribute("Randomize", StringValue(randomize));
+      // consumer catalog (of the content zone) and its popularity
+      consumerHelper.SetAttribute("CatalogSize", UintegerValue(catalog.catalogSize));
+      consumerHelper.SetAttribute("ZipfAlpha", DoubleValue(catalog.catalogAlpha));
+      consumerHelper.SetAttribute("ZipfQ", DoubleValue(catalog.catalogQ));
       // (inherited - CustomApp)
       consumerHelper.SetAttribute("SignPrefix", StringValue(m_signPrefix));
       consumerHelper.SetAttribute("SchemaPrefix", StringValue(m_schemaPrefix));
       consumerHelper.SetAttribute("ValidatorConf", StringValue(m_validatorConf));
+      consumerHelper.SetAttribute("TrustedZones", StringValue(m_trustedZones));
       // set random start time
-      for(auto &consumer : *m_consumers) {
-        Ptr<UniformRandomVariable> start_time = CreateObject<UniformRandomVariable>();
-        // consumer RANDOM start time interval (MIN, MAX)
-        consumerHelper.Install(consumer).Start(Seconds(start_time->GetValue(0.2, 0.75)));
-      }
+      Ptr<UniformRandomVariable> start_time = CreateObject<UniformRandomVariable>();
+      // consumer RANDOM start time interval (MIN, MAX)
+      consumerHelper.Install(consumer).Start(Seconds(start_time->GetValue(0.2, 0.75)));
     }
 
-    void CustomZone::installProducerApp(string prefix, double freshness, string payloadSize) {
+    void CustomZone::installProducerApp(NodeContainer &producers, string prefix, double freshness,
+                                        string payloadSize) {
       auto prefixApp = m_zoneName + prefix;
       // ndn::AppHelper producerHelper("ns3::ndn::Producer");
       NS_LOG_INFO("Installing Producer App for '" << prefixApp << "' ...");
@@ -80,11 +140,15 @@ namespace ns3 {
       producerHelper.SetPrefix(prefixApp);                                  // ndn prefix
       producerHelper.SetAttribute("PayloadSize", StringValue(payloadSize)); // payload MTU
       producerHelper.SetAttribute("Freshness", TimeValue(Seconds(freshness)));
+      producerHelper.SetAttribute("AttachCertificate", BooleanValue(m_workload.attachCertificate));
+      producerHelper.SetAttribute("BatchSize", UintegerValue(m_workload.batchSize));
       // (inherited - CustomApp)
       producerHelper.SetAttribute("SignPrefix", StringValue(m_signPrefix));
+      producerHelper.SetAttribute("GroupKeyPrefix", StringValue(m_groupKeyPrefix));
+      producerHelper.SetAttribute("GroupKey", BooleanValue(m_workload.groupKey));
       producerHelper.SetAttribute("SchemaPrefix", StringValue(m_schemaPrefix));
       producerHelper.SetAttribute("ValidatorConf", StringValue(m_validatorConf));
-      auto producersApps = std::make_shared<ns3::ApplicationContainer>(producerHelper.Install(*m_producers));
+      auto producersApps = std::make_shared<ns3::ApplicationContainer>(producerHelper.Install(producers));
       producersApps->Start(Seconds(0.1)); // producers start time
     }
 
@@ -99,10 +163,17 @@ namespace ns3 {
       //                                TimeValue(Seconds(freshness))); // freshness for trust schema file
       // // (inherited - CustomApp)
       trustAnchorHelper.SetAttribute("SignPrefix", StringValue(m_signPrefix));
+      trustAnchorHelper.SetAttribute("GroupKeyPrefix", StringValue(m_groupKeyPrefix));
+      trustAnchorHelper.SetAttribute("GroupKey", BooleanValue(m_workload.groupKey));
       trustAnchorHelper.SetAttribute("SchemaPrefix", StringValue(m_schemaPrefix));
       trustAnchorHelper.SetAttribute("ValidatorConf", StringValue(m_validatorConf));
-      auto trustAnchorApps =
-          std::make_shared<ns3::ApplicationContainer>(trustAnchorHelper.Install(*m_trust_anchors));
+      // anchors share the zone KEY and split SIGN requests among them
+      trustAnchorHelper.SetAttribute("AnchorCount", UintegerValue(m_trust_anchors->GetN()));
+      auto trustAnchorApps = std::make_shared<ns3::ApplicationContainer>();
+      for(uint32_t i = 0; i < m_trust_anchors->GetN(); i++) {
+        trustAnchorHelper.SetAttribute("AnchorIndex", UintegerValue(i));
+        trustAnchorApps->Add(trustAnchorHelper.Install(m_trust_anchors->Get(i)));
+      }
       trustAnchorApps->Start(Seconds(0.05)); // trust anchors start time
     }
 
@@ -37,14 +37,57 @@ namespace ns3 {
     class CustomZone {
 
     public:
-      CustomZone(std::string zoneName);
-      CustomZone(std::string zoneName, int n_Producers, int n_Consumers);
+      /// @brief content prefix (relative to the zone) and the producers serving it
+      struct PrefixSpec {
+        std::string prefix;
+        uint32_t producers;   ///< @brief zone producers serving the prefix (0 = all remaining, last only)
+        double freshness;     ///< @brief Data freshness (s)
+        uint32_t payloadSize; ///< @brief Data payload (bytes)
+
+        PrefixSpec(std::string prefix = "/test/prefix", uint32_t producers = 0, double freshness = 2.0,
+                   uint32_t payloadSize = 1480)
+            : prefix(prefix), producers(producers), freshness(freshness), payloadSize(payloadSize) {}
+      };
+
+      /// @brief demand of the zone: prefixes served by its producers, requested by consumers
+      struct Workload {
+        std::vector<PrefixSpec> prefixes; ///< @brief prefixes in popularity order (rank 1 first)
+        double zipfAlpha;                 ///< @brief Zipf popularity of prefixes (0 = uniform)
+        double rateMin;                   ///< @brief consumer Interests/s drawn from [rateMin, rateMax]
+        double rateMax;
+        std::string lifetime;  ///< @brief Interest lifetime
+        std::string randomize; ///< @brief consumer send time randomizer (none, uniform, exponential)
+        uint32_t catalogSize;  ///< @brief names /<prefix>/<rank> per prefix (0 = only /<prefix>)
+        double catalogAlpha;   ///< @brief Zipf-Mandelbrot popularity of the catalog names
+        double catalogQ;
+        bool attachCertificate; ///< @brief producers bundle their certificate with content Data
+        uint32_t batchSize;     ///< @brief content Data signed per Merkle batch (1 = per-packet signatures)
+        bool groupKey;          ///< @brief enrolled producers sign content Data with the zone group HMAC key
+
+        Workload()
+            : prefixes({PrefixSpec()}), zipfAlpha(0.0), rateMin(10.0), rateMax(10.0), lifetime("1s"),
+              randomize("uniform"), catalogSize(0), catalogAlpha(0.7), catalogQ(0.0),
+              attachCertificate(false), batchSize(1), groupKey(false) {}
+      };
+
+    public:
+      CustomZone(std::string zoneName, int n_TrustAnchors = 1);
+      CustomZone(std::string zoneName, int n_Producers, int n_Consumers, int n_TrustAnchors = 1);
       ~CustomZone();
 
       std::shared_ptr<NodeContainer> getTrustAnchors();
       std::shared_ptr<NodeContainer> getProducers();
       std::shared_ptr<NodeContainer> getConsumers();
 
+      std::string getZoneName();
+      std::string getValidatorConf();
+
+      /// @brief consumers request content of another zone (and trust its SCHEMA)
+      void setContentZone(std::shared_ptr<CustomZone> zone);
+
+      const Workload &getWorkload();
+      void setWorkload(const Workload &workload);
+
       void addProducers(int n);
       void addConsumers(int n);
 
@@ -53,22 +96,30 @@ namespace ns3 {
       void installAllConsumerApps();
 
     private:
-      void addTrustAnchor();
+      void addTrustAnchors(int n);
 
       void signProducerCertificates(std::shared_ptr<ns3::ApplicationContainer> producerApps);
 
       void installTrustAnchorApp(double freshness);
-      void installProducerApp(string prefix, double freshness, string payloadSize);
-      void installConsumerApp(string prefix, string lifetime, double pktFreq, string randomize);
+      void installProducerApp(NodeContainer &producers, string prefix, double freshness, string payloadSize);
+      void installConsumerApp(Ptr<Node> consumer, string prefix, string lifetime, double pktFreq,
+                              string randomize, const Workload &catalog);
 
     private:
       std::string m_zoneName;
       std::string m_schemaPrefix;
       std::string m_signPrefix;
+      std::string m_groupKeyPrefix;
 
       std::string m_trustAnchorCert;
       std::string m_validatorConf;
 
+      Workload m_workload;
+
+      std::string m_contentZoneName; ///< @brief zone requested by the consumers
+      CustomZone *m_contentZone;     ///< @brief (its workload gives the prefixes requested by the consumers)
+      std::string m_trustedZones;    ///< @brief "<zone>=<validatorConf>" of other zones trusted by consumers
+
       std::shared_ptr<NodeContainer> m_consumers;
       std::shared_ptr<NodeContainer> m_producers;
       std::shared_ptr<NodeContainer> m_trust_anchors;
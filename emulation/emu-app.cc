@@ -0,0 +1,107 @@
+// emu-app.cpp
+
+#include "emu-app.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/security/v2/certificate-fetcher-from-network.hpp"
+
+// system libs
+#include <stdexcept> // for standard exception classes
+
+namespace ns3 {
+  namespace ndn {
+
+    bool EmuApp::verbose = false;
+
+    EmuApp::EmuApp(const FaceFactory &makeFace, const ::ndn::Name &zonePrefix)
+        : m_keyChain("pib-memory:", "tpm-memory:"), m_face(makeFace(m_keyChain)),
+          m_scheduler(m_face->getIoService()), m_zonePrefix(zonePrefix),
+          m_signPrefix(zonePrefix.deepCopy().append("SIGN")),
+          m_schemaContentPrefix(zonePrefix.deepCopy().append("SCHEMA").append("CONTENT")),
+          m_schemaSubscribePrefix(zonePrefix.deepCopy().append("SCHEMA").append("SUBSCRIBE")),
+          m_interestLifetime(2000) {
+      auto policy = std::make_unique<CustomValidationPolicy>();
+      m_validationPolicy = policy.get();
+      m_validator = std::make_unique<::ndn::security::v2::Validator>(
+          std::move(policy), std::make_unique<::ndn::security::v2::CertificateFetcherFromNetwork>(*m_face));
+    }
+
+    EmuApp::~EmuApp() {}
+
+    void EmuApp::stop() {
+      m_scheduler.cancelAllEvents();
+      m_face->removeAllPendingInterests();
+    }
+
+    const EmuApp::Counters &EmuApp::getCounters() const { return m_counters; }
+
+    void EmuApp::setValidationRules(const ::ndn::security::v2::validator_config::ConfigSection &schema,
+                                    const ::ndn::security::v2::Certificate &anchor) {
+      try {
+        auto index = std::make_shared<CustomRuleIndex>();
+        index->load(schema);
+        m_validationPolicy->setRuleIndex(index);
+        m_validator->resetAnchors();
+        m_validator->loadAnchor(m_zonePrefix.toUri(), ::ndn::security::v2::Certificate(anchor));
+        EMU_LOG("Loaded " << index->size() << " validation rules (zone " << m_zonePrefix << ")");
+      } catch(const std::exception &e) {
+        throw std::runtime_error("Failed to set validation rules - Error=" + std::string(e.what()));
+      }
+    }
+
+    //////////////////////
+    //     PRIVATE      //
+    //////////////////////
+
+    void EmuApp::validate(const ::ndn::Data &data, std::function<void(const ::ndn::Data &)> onValidated) {
+      m_validator->validate(
+          data,
+          [this, onValidated](const ::ndn::Data &validated) {
+            m_counters.validated++;
+            onValidated(validated);
+          },
+          [this](const ::ndn::Data &failed, const ::ndn::security::v2::ValidationError &error) {
+            m_counters.validationFailures++;
+            EMU_LOG("Validation FAILED '" << failed.getName() << "' - Error=" << error);
+          });
+    }
+
+    void EmuApp::sign(::ndn::Data &data, const ::ndn::security::SigningInfo &signingInfo) {
+      auto begin = std::chrono::steady_clock::now();
+      m_keyChain.sign(data, signingInfo);
+      m_counters.signTime += std::chrono::steady_clock::now() - begin;
+      if(signingInfo.getSignerType() != ::ndn::security::SigningInfo::SIGNER_TYPE_SHA256) {
+        m_counters.signatures++; // digest-signed SCHEMA segments are not counted
+      }
+    }
+
+    void EmuApp::sendInterest(const ::ndn::Interest &interest, const ::ndn::DataCallback &onData,
+                              const ::ndn::TimeoutCallback &onTimeout) {
+      EMU_LOG("Sending Interest '" << interest.getName() << "'");
+      m_face->expressInterest(interest, onData,
+                              [onTimeout](const ::ndn::Interest &nacked, const ::ndn::lp::Nack &nack) {
+                                onTimeout(nacked); // Nack (e.g. congestion) handled as a timeout
+                              },
+                              onTimeout);
+    }
+
+    void EmuApp::setInterestFilter(const ::ndn::Name &prefix, const ::ndn::InterestCallback &onInterest) {
+      m_face->setInterestFilter(prefix, onInterest, [](const ::ndn::Name &failed, const std::string &reason) {
+        throw std::runtime_error("Failed to register prefix '" + failed.toUri() + "' - Error=" + reason);
+      });
+      EMU_LOG("Monitoring prefix '" << prefix << "'");
+    }
+
+    ::ndn::security::v2::Certificate EmuApp::createCertificate(const ::ndn::Name &prefix) {
+      try {
+        auto identity = m_keyChain.createIdentity(prefix, ::ndn::RsaKeyParams());
+        m_keyChain.setDefaultIdentity(identity);
+        return identity.getDefaultKey().getDefaultCertificate();
+      } catch(const std::exception &e) {
+        throw std::runtime_error("Failed to create certificate for '" + prefix.toUri() +
+                                 "' - Error=" + e.what());
+      }
+    }
+
+  } // namespace ndn
+} // namespace ns3
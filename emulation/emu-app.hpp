@@ -0,0 +1,99 @@
+// emu-app.hpp
+
+#ifndef EMU_APP_H_
+#define EMU_APP_H_
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/face.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/key-chain.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/signing-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validator.hpp"
+#include "ns3/ndnSIM/ndn-cxx/security/v2/validator-config/common.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/scheduler.hpp"
+
+// system libs
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// custom includes
+#include "../custom-rule-index.hpp"
+
+#define EMU_LOG(msg)                                                                                       \
+  do {                                                                                                     \
+    if(::ns3::ndn::EmuApp::verbose) {                                                                      \
+      std::clog << msg << std::endl;                                                                       \
+    }                                                                                                      \
+  } while(0)
+
+namespace ns3 {
+  namespace ndn {
+
+    /**
+     * @brief Protocol logic of CustomApp on a real ndn::Face, outside of ns-3 (emulation mode).
+     *
+     * The Face is connected to a local NFD (Unix socket) or to an in-process stand-in forwarder
+     * (linked DummyClientFace). Every app has its own in-memory KeyChain, and validates Data with the
+     * same CustomRuleIndex / CustomValidationPolicy as the simulated apps. Counters are wall-clock.
+     */
+    class EmuApp {
+    public:
+      /// @brief creates the Face of an app (prefix registrations are signed with the app KeyChain)
+      typedef std::function<std::shared_ptr<::ndn::Face>(::ndn::KeyChain &keyChain)> FaceFactory;
+
+      struct Counters {
+        size_t signatures = 0;
+        std::chrono::nanoseconds signTime{0}; ///< @brief wall-clock time spent signing
+        size_t validated = 0;
+        size_t validationFailures = 0;
+      };
+
+      static bool verbose;
+
+    public:
+      EmuApp(const FaceFactory &makeFace, const ::ndn::Name &zonePrefix);
+      virtual ~EmuApp();
+
+      virtual void start() = 0;
+      void stop();
+
+      const Counters &getCounters() const;
+
+      /// @brief trust schema rules and zone trust anchor (out-of-band, as the trust anchor .cert)
+      void setValidationRules(const ::ndn::security::v2::validator_config::ConfigSection &schema,
+                              const ::ndn::security::v2::Certificate &anchor);
+
+    protected:
+      void validate(const ::ndn::Data &data, std::function<void(const ::ndn::Data &)> onValidated);
+      void sign(::ndn::Data &data, const ::ndn::security::SigningInfo &signingInfo);
+      void sendInterest(const ::ndn::Interest &interest, const ::ndn::DataCallback &onData,
+                        const ::ndn::TimeoutCallback &onTimeout);
+      void setInterestFilter(const ::ndn::Name &prefix, const ::ndn::InterestCallback &onInterest);
+
+      /// @brief identity with a self-signed RSA certificate (rules use rsa-sha256 checkers)
+      ::ndn::security::v2::Certificate createCertificate(const ::ndn::Name &prefix);
+
+    protected:
+      ::ndn::KeyChain m_keyChain;
+      std::shared_ptr<::ndn::Face> m_face;
+      ::ndn::Scheduler m_scheduler;
+
+      ::ndn::Name m_zonePrefix;
+      ::ndn::Name m_signPrefix;          ///< @brief /<zone>/SIGN
+      ::ndn::Name m_schemaContentPrefix; ///< @brief /<zone>/SCHEMA/CONTENT
+      ::ndn::Name m_schemaSubscribePrefix;
+
+      ::ndn::time::milliseconds m_interestLifetime;
+      Counters m_counters;
+
+    private:
+      CustomValidationPolicy *m_validationPolicy;
+      std::unique_ptr<::ndn::security::v2::Validator> m_validator;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // EMU_APP_H_
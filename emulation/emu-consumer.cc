@@ -0,0 +1,150 @@
+// emu-consumer.cpp
+
+#include "emu-consumer.hpp"
+
+#include "../custom-schema-tlv.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/block-helpers.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    EmuConsumer::EmuConsumer(const FaceFactory &makeFace, const ::ndn::Name &zonePrefix,
+                             const ::ndn::security::v2::validator_config::ConfigSection &schema,
+                             const ::ndn::security::v2::Certificate &anchor)
+        : EmuApp(makeFace, zonePrefix), m_anchor(anchor), m_schemaVersion(0), m_schemaFetchVersion(0),
+          m_loadInterval(0), m_sequence(0) {
+      setValidationRules(schema, m_anchor);
+    }
+
+    void EmuConsumer::start() {
+      sendSubscribeInterest();
+      requestSchemaManifest();
+    }
+
+    void EmuConsumer::startLoad(const std::vector<::ndn::Name> &producers, double rate) {
+      if(producers.empty() || rate <= 0) {
+        return;
+      }
+      m_producers = producers;
+      m_loadInterval = ::ndn::time::nanoseconds(static_cast<int64_t>(1e9 / rate));
+      sendContentInterest();
+    }
+
+    const EmuConsumer::LoadCounters &EmuConsumer::getLoadCounters() const { return m_loadCounters; }
+
+    uint64_t EmuConsumer::getSchemaVersion() const { return m_schemaVersion; }
+
+    //////////////////////
+    //     PRIVATE      //
+    //////////////////////
+
+    /// @brief long-lived SUBSCRIBE Interest, answered by the trust anchor when the SCHEMA changes
+    void EmuConsumer::sendSubscribeInterest() {
+      ::ndn::Interest interest(m_schemaSubscribePrefix);
+      interest.setCanBePrefix(false);
+      interest.setMustBeFresh(true);
+      interest.setInterestLifetime(::ndn::time::seconds(4));
+      sendInterest(interest,
+                   [this](const ::ndn::Interest &, const ::ndn::Data &data) {
+                     sendSubscribeInterest();
+                     validate(data, [this](const ::ndn::Data &subscribe) {
+                       auto &content = subscribe.getContent();
+                       auto version = ::ndn::encoding::readNonNegativeInteger(content.blockFromValue());
+                       if(version > m_schemaVersion) {
+                         requestSchemaManifest();
+                       }
+                     });
+                   },
+                   [this](const ::ndn::Interest &) {
+                     // timeout or Nack (e.g. trust anchor not registered yet)
+                     auto retry = [this] { sendSubscribeInterest(); };
+                     m_scheduler.schedule(::ndn::time::milliseconds(100), retry);
+                   });
+    }
+
+    void EmuConsumer::requestSchemaManifest() {
+      ::ndn::Interest interest(m_schemaContentPrefix);
+      interest.setCanBePrefix(false);
+      interest.setMustBeFresh(true);
+      interest.setInterestLifetime(m_interestLifetime);
+      sendInterest(interest,
+                   [this](const ::ndn::Interest &, const ::ndn::Data &data) {
+                     validate(data, [this](const ::ndn::Data &manifestData) {
+                       auto &content = manifestData.getContent();
+                       auto manifest = CustomSchemaTlv::decodeManifest(content.blockFromValue());
+                       if(manifest.version <= m_schemaVersion || manifest.version == m_schemaFetchVersion) {
+                         return; // already installed or being fetched
+                       }
+                       m_schemaFetchVersion = manifest.version;
+                       m_schemaDigests = manifest.digests;
+                       m_schemaPayload.clear();
+                       auto versionPrefix = m_schemaContentPrefix.deepCopy().appendVersion(manifest.version);
+                       requestSchemaSegment(versionPrefix, 0);
+                     });
+                   },
+                   [this](const ::ndn::Interest &) {
+                     // timeout or Nack: a missed manifest would leave the SCHEMA stale until the next change
+                     auto retry = [this] { requestSchemaManifest(); };
+                     m_scheduler.schedule(::ndn::time::milliseconds(100), retry);
+                   });
+    }
+
+    /// @brief segments in order, by full name (the validated manifest vouches for their digests)
+    void EmuConsumer::requestSchemaSegment(const ::ndn::Name &versionPrefix, size_t segment) {
+      ::ndn::Interest interest(
+          versionPrefix.deepCopy().appendSegment(segment).append(m_schemaDigests[segment]));
+      interest.setCanBePrefix(false);
+      interest.setInterestLifetime(m_interestLifetime);
+      auto version = m_schemaFetchVersion;
+      sendInterest(interest,
+                   [this, versionPrefix, segment, version](const ::ndn::Interest &, const ::ndn::Data &data) {
+                     if(version != m_schemaFetchVersion) {
+                       return; // superseded by a newer version
+                     }
+                     auto &content = data.getContent();
+                     m_schemaPayload.insert(m_schemaPayload.end(), content.value_begin(),
+                                            content.value_end());
+                     if(segment + 1 < m_schemaDigests.size()) {
+                       requestSchemaSegment(versionPrefix, segment + 1);
+                       return;
+                     }
+                     try {
+                       ::ndn::Block block(m_schemaPayload.data(), m_schemaPayload.size());
+                       setValidationRules(CustomSchemaTlv::decode(block), m_anchor);
+                       m_schemaVersion = version;
+                       EMU_LOG("Installed SCHEMA version=" << version << " (" << m_schemaPayload.size()
+                                                           << " bytes)");
+                     } catch(const std::exception &e) {
+                       EMU_LOG("Failed to decode SCHEMA version=" << version << " - Error=" << e.what());
+                     }
+                     m_schemaFetchVersion = 0;
+                   },
+                   [this, version](const ::ndn::Interest &) {
+                     if(version == m_schemaFetchVersion) {
+                       m_schemaFetchVersion = 0; // retried on the next SUBSCRIBE
+                     }
+                   });
+    }
+
+    void EmuConsumer::sendContentInterest() {
+      auto &producer = m_producers[m_sequence % m_producers.size()];
+      ::ndn::Interest interest(producer.deepCopy().appendNumber(m_sequence++));
+      interest.setCanBePrefix(false);
+      interest.setMustBeFresh(true);
+      interest.setInterestLifetime(m_interestLifetime);
+      auto sent = std::chrono::steady_clock::now();
+      m_loadCounters.requests++;
+      sendInterest(interest,
+                   [this, sent](const ::ndn::Interest &, const ::ndn::Data &data) {
+                     m_loadCounters.received++;
+                     m_loadCounters.rttSum += std::chrono::steady_clock::now() - sent;
+                     validate(data, [](const ::ndn::Data &) {});
+                   },
+                   [this](const ::ndn::Interest &) { m_loadCounters.timeouts++; });
+      m_loadEvent = m_scheduler.schedule(m_loadInterval, [this] { sendContentInterest(); });
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,61 @@
+// emu-consumer.hpp
+
+#ifndef EMU_CONSUMER_H_
+#define EMU_CONSUMER_H_
+
+#include "emu-app.hpp"
+
+// system libs
+#include <vector>
+
+namespace ns3 {
+  namespace ndn {
+
+    /// @brief CustomConsumer logic (SCHEMA SUBSCRIBE, segmented SCHEMA fetch) plus a content load generator
+    class EmuConsumer : public EmuApp {
+    public:
+      struct LoadCounters {
+        size_t requests = 0;
+        size_t received = 0;
+        size_t timeouts = 0;
+        std::chrono::nanoseconds rttSum{0}; ///< @brief Interest to Data (before validation)
+      };
+
+    public:
+      EmuConsumer(const FaceFactory &makeFace, const ::ndn::Name &zonePrefix,
+                  const ::ndn::security::v2::validator_config::ConfigSection &schema,
+                  const ::ndn::security::v2::Certificate &anchor);
+
+      void start() override;
+
+      /// @brief request content of the producers round-robin, at rate Interests/s (0 = no load)
+      void startLoad(const std::vector<::ndn::Name> &producers, double rate);
+
+      const LoadCounters &getLoadCounters() const;
+      uint64_t getSchemaVersion() const;
+
+    private:
+      void sendSubscribeInterest();
+      void requestSchemaManifest();
+      void requestSchemaSegment(const ::ndn::Name &versionPrefix, size_t segment);
+      void sendContentInterest();
+
+    private:
+      ::ndn::security::v2::Certificate m_anchor;
+
+      uint64_t m_schemaVersion;
+      std::vector<::ndn::name::Component> m_schemaDigests; ///< @brief segments of the version being fetched
+      uint64_t m_schemaFetchVersion;
+      ::ndn::Buffer m_schemaPayload;
+
+      std::vector<::ndn::Name> m_producers;
+      ::ndn::time::nanoseconds m_loadInterval;
+      uint64_t m_sequence;
+      LoadCounters m_loadCounters;
+      ::ndn::scheduler::ScopedEventId m_loadEvent;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // EMU_CONSUMER_H_
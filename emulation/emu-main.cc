@@ -0,0 +1,206 @@
+// emu-main.cpp
+
+#include "emu-consumer.hpp"
+#include "emu-producer.hpp"
+#include "emu-trust-anchor.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/transport/unix-transport.hpp"
+#include "ns3/ndnSIM/ndn-cxx/util/dummy-client-face.hpp"
+
+// boost libs
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+// system libs
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ns3::ndn;
+
+namespace {
+
+  const std::map<std::string, std::string> DEFAULT_OPTIONS = {
+      {"transport", "dummy"},
+      {"nfd", "/run/nfd.sock"},
+      {"zone", "/zoneA"},
+      {"producers", "10"},
+      {"consumers", "2"},
+      {"maxConcurrentSign", "4"},
+      {"rate", "100"},
+      {"duration", "10"},
+  };
+
+  void usage(const char *program) {
+    std::cerr << "Usage: " << program << " [--option=value ...] [-v]\n"
+              << "  --transport=dummy|nfd   in-process stand-in forwarder, or a local NFD\n"
+              << "  --nfd=<path>            NFD Unix socket (transport=nfd)\n"
+              << "  --zone=<prefix>         zone prefix\n"
+              << "  --producers=<n>         producers enrolling at start\n"
+              << "  --consumers=<n>         consumers (SCHEMA subscribers and load generators)\n"
+              << "  --maxConcurrentSign=<n> SIGN requests served at the same time by the trust anchor\n"
+              << "  --rate=<n>              content Interests/s per consumer, once all producers enrolled\n"
+              << "  --duration=<s>          wall-clock duration of the run\n"
+              << "  -v                      log the protocol messages\n";
+  }
+
+  double perSecond(size_t count, std::chrono::nanoseconds elapsed) {
+    return (elapsed.count() > 0 ? count * 1e9 / elapsed.count() : 0);
+  }
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options = DEFAULT_OPTIONS;
+  for(int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto separator = arg.find('=');
+    if(arg == "-v") {
+      EmuApp::verbose = true;
+    } else if(arg.compare(0, 2, "--") == 0 && separator != std::string::npos &&
+              options.count(arg.substr(2, separator - 2)) > 0) {
+      options[arg.substr(2, separator - 2)] = arg.substr(separator + 1);
+    } else {
+      usage(argv[0]);
+      return (arg == "-h" || arg == "--help" ? 0 : 1);
+    }
+  }
+
+  try {
+    boost::asio::io_service io;
+    ::ndn::Name zone(options["zone"]);
+    size_t nProducers = std::stoul(options["producers"]);
+    size_t nConsumers = std::stoul(options["consumers"]);
+    double rate = std::stod(options["rate"]);
+    auto duration = std::chrono::duration<double>(std::stod(options["duration"]));
+
+    // every app has its own Face (and KeyChain), as an app on its own node
+    std::shared_ptr<::ndn::util::DummyClientFace> hub;
+    EmuApp::FaceFactory makeFace;
+    if(options["transport"] == "nfd") {
+      auto socket = options["nfd"];
+      makeFace = [&io, socket](::ndn::KeyChain &keyChain) {
+        return std::make_shared<::ndn::Face>(::ndn::UnixTransport::create("unix://" + socket), io, keyChain);
+      };
+    } else if(options["transport"] == "dummy") {
+      // broadcast link between the faces of the apps (stand-in for the forwarder)
+      static ::ndn::KeyChain hubKeyChain("pib-memory:", "tpm-memory:");
+      hub = std::make_shared<::ndn::util::DummyClientFace>(
+          io, hubKeyChain, ::ndn::util::DummyClientFace::Options{false, false});
+      makeFace = [&io, hub](::ndn::KeyChain &keyChain) {
+        // registration reply: the Interest filters of the app are only installed once registered
+        auto face = std::make_shared<::ndn::util::DummyClientFace>(
+            io, keyChain, ::ndn::util::DummyClientFace::Options{false, true});
+        face->linkTo(*hub);
+        return std::static_pointer_cast<::ndn::Face>(face);
+      };
+    } else {
+      throw std::runtime_error("Unknown transport '" + options["transport"] + "'");
+    }
+
+    // zone trust anchor, its certificate and initial schema are distributed out-of-band
+    EmuTrustAnchor trustAnchor(makeFace, zone, std::stoul(options["maxConcurrentSign"]));
+    std::vector<std::unique_ptr<EmuProducer>> producers;
+    std::vector<std::unique_ptr<EmuConsumer>> consumers;
+    for(size_t i = 0; i < nConsumers; i++) {
+      consumers.emplace_back(std::make_unique<EmuConsumer>(makeFace, zone, trustAnchor.getSchema(),
+                                                           trustAnchor.getZoneCertificate()));
+    }
+
+    // load generator starts once every producer is enrolled
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds enrollmentTime{0};
+    size_t nEnrolled = 0;
+    auto onEnrolled = [&](EmuProducer &) {
+      if(++nEnrolled < nProducers) {
+        return;
+      }
+      enrollmentTime = std::chrono::steady_clock::now() - start;
+      std::vector<::ndn::Name> identities;
+      for(const auto &producer : producers) {
+        identities.push_back(producer->getIdentity());
+      }
+      for(auto &consumer : consumers) {
+        consumer->startLoad(identities, rate);
+      }
+    };
+    for(size_t i = 0; i < nProducers; i++) {
+      auto identity = zone.deepCopy().append("producer" + std::to_string(i));
+      producers.emplace_back(std::make_unique<EmuProducer>(makeFace, zone, identity, onEnrolled));
+      producers.back()->setValidationRules(trustAnchor.getSchema(), trustAnchor.getZoneCertificate());
+    }
+
+    start = std::chrono::steady_clock::now();
+    trustAnchor.start();
+    for(auto &consumer : consumers) {
+      consumer->start();
+    }
+    for(auto &producer : producers) {
+      producer->start();
+    }
+    boost::asio::steady_timer timer(io, std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+    timer.async_wait([&](const boost::system::error_code &) {
+      trustAnchor.stop();
+      for(auto &producer : producers) {
+        producer->stop();
+      }
+      for(auto &consumer : consumers) {
+        consumer->stop();
+      }
+      io.stop();
+    });
+    io.run();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // REPORT (wall-clock)
+    size_t producerSignatures = 0, signRetries = 0;
+    std::chrono::nanoseconds producerSignTime{0};
+    for(const auto &producer : producers) {
+      producerSignatures += producer->getCounters().signatures;
+      producerSignTime += producer->getCounters().signTime;
+      signRetries += producer->getSignRetries();
+    }
+    EmuConsumer::LoadCounters load;
+    size_t validated = 0, failures = 0;
+    for(const auto &consumer : consumers) {
+      load.requests += consumer->getLoadCounters().requests;
+      load.received += consumer->getLoadCounters().received;
+      load.timeouts += consumer->getLoadCounters().timeouts;
+      load.rttSum += consumer->getLoadCounters().rttSum;
+      validated += consumer->getCounters().validated;
+      failures += consumer->getCounters().validationFailures;
+    }
+    auto &anchorCounters = trustAnchor.getCounters();
+    std::cout << std::fixed << std::setprecision(2) << "transport=" << options["transport"]
+              << " duration=" << std::chrono::duration<double>(elapsed).count() << "s\n"
+              << "enrollment: " << nEnrolled << "/" << nProducers << " producers";
+    if(nEnrolled == nProducers && nProducers > 0) {
+      std::cout << " in " << std::chrono::duration<double>(enrollmentTime).count() << "s ("
+                << perSecond(nEnrolled, enrollmentTime) << " enroll/s)";
+    }
+    std::cout << ", " << signRetries << " SIGN Interests\n"
+              << "trust anchor: " << anchorCounters.signatures << " signatures, "
+              << perSecond(anchorCounters.signatures, anchorCounters.signTime) << " sign/s (CPU)\n"
+              << "producers: " << producerSignatures << " signatures, "
+              << perSecond(producerSignatures, producerSignTime) << " sign/s (CPU), "
+              << perSecond(producerSignatures, elapsed) << " sign/s (wall)\n"
+              << "consumers: " << load.received << "/" << load.requests << " Data (" << load.timeouts
+              << " timeouts), " << validated << " validated (" << perSecond(validated, elapsed)
+              << "/s), " << failures << " validation failures";
+    if(load.received > 0) {
+      std::cout << ", mean RTT "
+                << std::chrono::duration<double, std::milli>(load.rttSum).count() / load.received << "ms";
+    }
+    std::cout << std::endl;
+    return (nEnrolled == nProducers ? EXIT_SUCCESS : EXIT_FAILURE);
+  } catch(const std::exception &e) {
+    std::cerr << "Failed to run emulation - Error=" << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
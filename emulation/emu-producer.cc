@@ -0,0 +1,97 @@
+// emu-producer.cpp
+
+#include "emu-producer.hpp"
+
+// system libs
+#include <algorithm>
+#include <random>
+
+namespace ns3 {
+  namespace ndn {
+
+    const ::ndn::time::milliseconds EmuProducer::SIGN_BACKOFF_MAX(16000);
+
+    EmuProducer::EmuProducer(const FaceFactory &makeFace, const ::ndn::Name &zonePrefix,
+                             const ::ndn::Name &identity, const EnrolledCallback &onEnrolled)
+        : EmuApp(makeFace, zonePrefix), m_identityPrefix(identity), m_onEnrolled(onEnrolled),
+          m_signCompleted(false), m_signRetries(0) {
+      m_cert = createCertificate(m_identityPrefix);
+    }
+
+    void EmuProducer::start() {
+      setInterestFilter(m_identityPrefix,
+                        [this](const ::ndn::InterestFilter &, const ::ndn::Interest &interest) {
+                          onInterestContent(interest);
+                        });
+      sendSignInterest();
+    }
+
+    const ::ndn::Name &EmuProducer::getIdentity() const { return m_identityPrefix; }
+
+    bool EmuProducer::isEnrolled() const { return m_signCompleted; }
+
+    size_t EmuProducer::getSignRetries() const { return m_signRetries; }
+
+    //////////////////////
+    //     PRIVATE      //
+    //////////////////////
+
+    void EmuProducer::onInterestContent(const ::ndn::Interest &interest) {
+      if(m_cert.getKeyName().isPrefixOf(interest.getName())) {
+        m_face->put(m_cert); // KEY request (trust anchor SIGN or validators fetching the chain)
+        return;
+      }
+      // freshly signed content, so the load generator measures the signing rate
+      ::ndn::Data data(interest.getName());
+      data.setFreshnessPeriod(::ndn::time::milliseconds(1));
+      data.setContent(reinterpret_cast<const uint8_t *>(m_identityPrefix.toUri().data()),
+                      m_identityPrefix.toUri().size());
+      sign(data, ::ndn::security::signingByIdentity(m_identityPrefix));
+      m_face->put(data);
+    }
+
+    /// @brief SIGN, then retry with exponential backoff until signed
+    void EmuProducer::sendSignInterest() {
+      if(m_signCompleted) {
+        return;
+      }
+      ::ndn::Interest interest(m_signPrefix.deepCopy().append(m_cert.getKeyName()));
+      interest.setCanBePrefix(true);
+      interest.setMustBeFresh(true);
+      interest.setInterestLifetime(m_interestLifetime);
+      sendInterest(interest, [this](const ::ndn::Interest &, const ::ndn::Data &data) { onDataSign(data); },
+                   [](const ::ndn::Interest &) {});
+      m_signRetries++;
+
+      // SignLifetime * 2^(retries - 1), capped, plus a random jitter
+      static std::mt19937 rng(std::random_device{}());
+      auto backoff = std::min<::ndn::time::milliseconds>(
+          m_interestLifetime * (1 << std::min<size_t>(m_signRetries - 1, 16)), SIGN_BACKOFF_MAX);
+      auto jitter = ::ndn::time::milliseconds(std::uniform_int_distribution<int>(0, 100)(rng));
+      m_signEvent = m_scheduler.schedule(backoff + jitter, [this] { sendSignInterest(); });
+    }
+
+    void EmuProducer::onDataSign(const ::ndn::Data &data) {
+      validate(data, [this](const ::ndn::Data &signData) {
+        if(m_signCompleted) {
+          return;
+        }
+        try {
+          ::ndn::security::v2::Certificate cert(signData.getContent().blockFromValue());
+          auto key = m_keyChain.getPib().getIdentity(m_identityPrefix).getKey(cert.getKeyName());
+          m_keyChain.addCertificate(key, cert);
+          m_keyChain.setDefaultCertificate(key, cert);
+          m_cert = cert;
+        } catch(const std::exception &e) {
+          EMU_LOG("Failed to install CERTIFICATE of '" << m_identityPrefix << "' - Error=" << e.what());
+          return;
+        }
+        m_signCompleted = true;
+        m_signEvent.cancel();
+        EMU_LOG("SIGN completed for '" << m_identityPrefix << "' after " << m_signRetries << " Interests");
+        m_onEnrolled(*this);
+      });
+    }
+
+  } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,46 @@
+// emu-producer.hpp
+
+#ifndef EMU_PRODUCER_H_
+#define EMU_PRODUCER_H_
+
+#include "emu-app.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    /// @brief CustomProducer logic (KEY, SIGN with backoff, signed content) on a real Face
+    class EmuProducer : public EmuApp {
+    public:
+      typedef std::function<void(EmuProducer &producer)> EnrolledCallback;
+
+    public:
+      EmuProducer(const FaceFactory &makeFace, const ::ndn::Name &zonePrefix, const ::ndn::Name &identity,
+                  const EnrolledCallback &onEnrolled);
+
+      void start() override;
+
+      const ::ndn::Name &getIdentity() const;
+      bool isEnrolled() const;
+      size_t getSignRetries() const;
+
+    private:
+      void onInterestContent(const ::ndn::Interest &interest);
+      void sendSignInterest();
+      void onDataSign(const ::ndn::Data &data);
+
+    private:
+      static const ::ndn::time::milliseconds SIGN_BACKOFF_MAX;
+
+      ::ndn::Name m_identityPrefix;
+      ::ndn::security::v2::Certificate m_cert; ///< @brief default certificate (zone-issued once enrolled)
+      EnrolledCallback m_onEnrolled;
+
+      bool m_signCompleted;
+      size_t m_signRetries;
+      ::ndn::scheduler::ScopedEventId m_signEvent;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // EMU_PRODUCER_H_
@@ -0,0 +1,169 @@
+// emu-trust-anchor.cpp
+
+#include "emu-trust-anchor.hpp"
+
+#include "../custom-certificate-issuer.hpp"
+#include "../custom-schema-rules.hpp"
+#include "../custom-schema-tlv.hpp"
+
+// NDN-CXX
+#include "ns3/ndnSIM/ndn-cxx/encoding/block-helpers.hpp"
+#include "ns3/ndnSIM/ndn-cxx/lp/nack.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    const size_t EmuTrustAnchor::SCHEMA_SEGMENT_SIZE;
+
+    EmuTrustAnchor::EmuTrustAnchor(const FaceFactory &makeFace, const ::ndn::Name &zonePrefix,
+                                   size_t maxConcurrentSign)
+        : EmuApp(makeFace, zonePrefix), m_maxConcurrentSign(maxConcurrentSign),
+          m_schemaPublisher(m_schemaContentPrefix, SCHEMA_SEGMENT_SIZE) {
+      m_zoneCert = createCertificate(m_zonePrefix);
+      m_signingInfo = ::ndn::security::signingByIdentity(m_zonePrefix);
+      // segments are immutable (named by version and digest), the manifest names the latest version
+      m_schemaPublisher.setFreshness(::ndn::time::hours(1), ::ndn::time::milliseconds(1));
+
+      // SIGN and SCHEMA protocols (validated with the zone KEY)
+      addValidationRule(CustomSchemaRules::createZoneRule(m_signPrefix, m_zonePrefix));
+      auto schemaPrefix = m_zonePrefix.deepCopy().append("SCHEMA");
+      addValidationRule(CustomSchemaRules::createZoneRule(schemaPrefix, m_zonePrefix));
+    }
+
+    void EmuTrustAnchor::start() {
+      setInterestFilter(m_signPrefix, [this](const ::ndn::InterestFilter &, const ::ndn::Interest &interest) {
+        onInterestSign(interest);
+      });
+      setInterestFilter(m_zonePrefix.deepCopy().append("KEY"),
+                        [this](const ::ndn::InterestFilter &, const ::ndn::Interest &interest) {
+                          m_face->put(m_zoneCert);
+                        });
+      setInterestFilter(m_zonePrefix.deepCopy().append("SCHEMA"),
+                        [this](const ::ndn::InterestFilter &, const ::ndn::Interest &interest) {
+                          onInterestSchema(interest);
+                        });
+      updateSchemaSegments();
+    }
+
+    const ::ndn::security::v2::Certificate &EmuTrustAnchor::getZoneCertificate() const { return m_zoneCert; }
+
+    const ::ndn::security::v2::validator_config::ConfigSection &EmuTrustAnchor::getSchema() const {
+      return m_schema;
+    }
+
+    size_t EmuTrustAnchor::getIssuedCertificates() const { return m_signResponses.size(); }
+
+    //////////////////////
+    //     PRIVATE      //
+    //////////////////////
+
+    void EmuTrustAnchor::onInterestSign(const ::ndn::Interest &interest) {
+      // admission control: one request per KEY, bounded concurrency (saturated = Nack, producer backs off)
+      auto keyName = interest.getName().getSubName(m_signPrefix.size());
+      auto it = m_signResponses.find(keyName);
+      if(it != m_signResponses.end()) {
+        EMU_LOG("Replaying SIGN response for '" << keyName << "'");
+        m_face->put(*it->second);
+      } else if(m_signRequests.count(keyName) > 0) {
+        EMU_LOG("SIGN request for '" << keyName << "' already pending, ignoring duplicate");
+      } else if(m_signRequests.size() < m_maxConcurrentSign) {
+        m_signRequests.insert(keyName);
+        ::ndn::Interest keyInterest(keyName);
+        keyInterest.setCanBePrefix(true);
+        keyInterest.setMustBeFresh(true);
+        keyInterest.setInterestLifetime(m_interestLifetime);
+        sendInterest(keyInterest,
+                     [this, keyName](const ::ndn::Interest &, const ::ndn::Data &data) {
+                       onDataProducerKey(keyName, data);
+                     },
+                     [this, keyName](const ::ndn::Interest &) {
+                       EMU_LOG("SIGN request for '" << keyName << "' timed out");
+                       finishSignRequest(keyName);
+                     });
+      } else {
+        m_face->put(::ndn::lp::Nack(interest).setReason(::ndn::lp::NackReason::CONGESTION));
+      }
+    }
+
+    void EmuTrustAnchor::onInterestSchema(const ::ndn::Interest &interest) {
+      auto &dataName = interest.getName();
+      if(dataName == m_schemaContentPrefix) {
+        m_face->put(*m_schemaPublisher.getManifest());
+      } else if(m_schemaContentPrefix.isPrefixOf(dataName)) {
+        auto segment = m_schemaPublisher.findSegment(interest);
+        if(segment == nullptr) {
+          EMU_LOG("Dropping interest '" << dataName
+                                        << "' - SCHEMA version=" << m_schemaPublisher.getVersion());
+          return;
+        }
+        m_face->put(*segment);
+      }
+      // SUBSCRIBE Interests stay pending until the next sendDataSubscribe()
+    }
+
+    void EmuTrustAnchor::onDataProducerKey(const ::ndn::Name &keyName, const ::ndn::Data &data) {
+      // enrollment (producer authentication) is out of scope, as in the simulation
+      try {
+        // /<prefix>/KEY/keyID/signerID/versionID (same version: a reissue has the same name)
+        auto issuance = CustomCertificateIssuer::prepare(data, ::ndn::name::Component("anchor"), m_signPrefix,
+                                                         data.getFreshnessPeriod());
+        sign(*issuance.certificate, m_signingInfo);
+        CustomCertificateIssuer::setCertificate(issuance);
+        sign(*issuance.response, m_signingInfo);
+        m_signResponses[keyName] = issuance.response;
+        m_face->put(*issuance.response);
+        EMU_LOG("Issued CERTIFICATE '" << issuance.certificate->getName() << "'");
+
+        addProducerSchema(::ndn::security::v2::extractIdentityFromCertName(issuance.certificate->getName()));
+      } catch(const std::exception &e) {
+        EMU_LOG("Failed to sign KEY '" << data.getName() << "' - Error=" << e.what());
+      }
+      finishSignRequest(keyName);
+    }
+
+    void EmuTrustAnchor::finishSignRequest(const ::ndn::Name &keyName) { m_signRequests.erase(keyName); }
+
+    void EmuTrustAnchor::addProducerSchema(const ::ndn::Name &identityName) {
+      if(!m_enrolledIdentities.insert(identityName).second) {
+        return;
+      }
+      addValidationRule(CustomSchemaRules::createProducerKeyRule(identityName, m_zonePrefix));
+      addValidationRule(CustomSchemaRules::createProducerAppRule(identityName));
+
+      // inform the network about the changes in the schema
+      sendDataSubscribe();
+    }
+
+    void
+    EmuTrustAnchor::addValidationRule(const ::ndn::security::v2::validator_config::ConfigSection &rule) {
+      m_schema.push_front(std::make_pair("rule", rule));
+    }
+
+    /// @brief split the current SCHEMA into segments (new version only if the payload has changed)
+    void EmuTrustAnchor::updateSchemaSegments() {
+      auto block = CustomSchemaTlv::encode(m_schema);
+      auto signSchema = [this](::ndn::Data &data, const ::ndn::security::SigningInfo &signingInfo) {
+        sign(data, signingInfo);
+      };
+      if(!m_schemaPublisher.update(::ndn::Buffer(block.wire(), block.size()), m_enrolledIdentities.size(),
+                                   m_signingInfo, signSchema)) {
+        return;
+      }
+      EMU_LOG("SCHEMA version=" << m_schemaPublisher.getVersion() << " - "
+                                << m_schemaPublisher.getPayload().size() << " bytes in "
+                                << m_schemaPublisher.getSegmentCount() << " segments");
+    }
+
+    // reply with SCHEMA/SUBCRIBE
+    void EmuTrustAnchor::sendDataSubscribe() {
+      updateSchemaSegments();
+      ::ndn::Data data(m_schemaSubscribePrefix);
+      data.setFreshnessPeriod(::ndn::time::milliseconds(1)); // notification, not to be answered by caches
+      data.setContent(::ndn::encoding::makeNonNegativeIntegerBlock(CustomSchemaTlv::Version,
+                                                                   m_schemaPublisher.getVersion()));
+      sign(data, m_signingInfo);
+      m_face->put(data);
+    }
+
+  } // namespace ndn
+} // namespace ns3
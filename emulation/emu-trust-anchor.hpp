@@ -0,0 +1,62 @@
+// emu-trust-anchor.hpp
+
+#ifndef EMU_TRUST_ANCHOR_H_
+#define EMU_TRUST_ANCHOR_H_
+
+#include "emu-app.hpp"
+
+// system libs
+#include <map>
+#include <memory>
+#include <set>
+
+// custom includes
+#include "../custom-schema-publisher.hpp"
+
+namespace ns3 {
+  namespace ndn {
+
+    /// @brief CustomTrustAnchor logic (SIGN, zone KEY, segmented SCHEMA and SUBSCRIBE) on a real Face
+    class EmuTrustAnchor : public EmuApp {
+    public:
+      EmuTrustAnchor(const FaceFactory &makeFace, const ::ndn::Name &zonePrefix, size_t maxConcurrentSign);
+
+      void start() override;
+
+      /// @brief zone trust anchor, distributed out-of-band to the other apps (as the .cert file)
+      const ::ndn::security::v2::Certificate &getZoneCertificate() const;
+      /// @brief initial trust schema (SIGN and SCHEMA rules), distributed out-of-band with the anchor
+      const ::ndn::security::v2::validator_config::ConfigSection &getSchema() const;
+
+      size_t getIssuedCertificates() const;
+
+    private:
+      void onInterestSign(const ::ndn::Interest &interest);
+      void onInterestSchema(const ::ndn::Interest &interest);
+      void onDataProducerKey(const ::ndn::Name &keyName, const ::ndn::Data &data);
+      void finishSignRequest(const ::ndn::Name &keyName);
+
+      void addProducerSchema(const ::ndn::Name &identityName);
+      void addValidationRule(const ::ndn::security::v2::validator_config::ConfigSection &rule);
+      void updateSchemaSegments();
+      void sendDataSubscribe();
+
+    private:
+      static const size_t SCHEMA_SEGMENT_SIZE = 1200;
+
+      ::ndn::security::v2::Certificate m_zoneCert;
+      ::ndn::security::SigningInfo m_signingInfo;
+
+      size_t m_maxConcurrentSign;
+      std::set<::ndn::Name> m_signRequests; ///< @brief KEY names being signed
+      std::map<::ndn::Name, std::shared_ptr<::ndn::Data>> m_signResponses;
+      std::set<::ndn::Name> m_enrolledIdentities;
+
+      ::ndn::security::v2::validator_config::ConfigSection m_schema;
+      CustomSchemaPublisher m_schemaPublisher;
+    };
+
+  } // namespace ndn
+} // namespace ns3
+
+#endif // EMU_TRUST_ANCHOR_H_
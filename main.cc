@@ -1,7 +1,10 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 
+#include <chrono>
+#include <fstream>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -55,9 +58,20 @@
 #include "ns3/ndnSIM/ndn-cxx/util/io.hpp"
 
 // custom and auxiliary
+#include "custom-benchmark.hpp"
 #include "custom-consumer.hpp"
+#include "custom-cpu-model.hpp"
+#include "custom-crypto-energy-model.hpp"
+#include "custom-crypto-pool.hpp"
+#include "custom-cs-policy.hpp"
+#include "custom-event-log.hpp"
 #include "custom-producer.hpp"
+#include "custom-profiler.hpp"
+#include "custom-scenario.hpp"
+#include "custom-schema-store.hpp"
+#include "custom-snapshot.hpp"
 #include "custom-tracer.hpp"
+#include "custom-utils.hpp"
 #include "custom-zone.hpp"
 
 NS_LOG_COMPONENT_DEFINE("sim_bootsec");
@@ -79,6 +93,99 @@ namespace ns3 {
     return uri;
   }
 
+  void SignRetriesTrace(Ptr<OutputStreamWrapper> stream, Ptr<ndn::App> app, uint32_t retries, Time delay) {
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "\t" << app->GetNode()->GetId() << "\t"
+                         << app->GetId() << "\t" << retries << "\t" << delay.GetSeconds() << "\n";
+  }
+
+  void CertificateIssuedTrace(Ptr<OutputStreamWrapper> stream, Ptr<ndn::App> app, const ndn::Name &certName) {
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "\t" << app->GetNode()->GetId() << "\t"
+                         << certName << "\n";
+  }
+
+  void SignServiceTimeTrace(Ptr<OutputStreamWrapper> stream, Ptr<ndn::App> app, Time serviceTime) {
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "\t" << app->GetNode()->GetId() << "\t"
+                         << "ServiceTime\t" << serviceTime.GetSeconds() << "\n";
+  }
+
+  void SignQueueDepthTrace(Ptr<OutputStreamWrapper> stream, std::string context, uint32_t oldDepth,
+                           uint32_t newDepth) {
+    // context = /NodeList/<id>/ApplicationList/...
+    auto nodeId = context.substr(10, context.find('/', 10) - 10);
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "\t" << nodeId << "\t"
+                         << "QueueDepth\t" << newDepth << "\n";
+  }
+
+  void CpuBusyCoresTrace(Ptr<OutputStreamWrapper> stream, std::string context, uint32_t oldBusy,
+                         uint32_t newBusy) {
+    // context = /NodeList/<id>/$CustomCpuModel/BusyCores
+    auto nodeId = context.substr(10, context.find('/', 10) - 10);
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "\t" << nodeId << "\t"
+                         << "BusyCores\t" << newBusy << "\n";
+  }
+
+  /// @brief time-to-trust metrics of one run (one CSV row, see --nTimeToTrust)
+  struct TrustMetrics {
+    std::set<ndn::Name> enrolledKeys;          ///< @brief producer KEYs with an issued certificate
+    std::set<Ptr<ndn::App>> trustingConsumers; ///< @brief consumer apps that validated content
+    uint32_t nProducers = 0;
+    uint32_t nConsumers = 0;
+    double enrollmentTime = -1; ///< @brief (s) every producer enrolled
+    double trustTime = -1;      ///< @brief (s) every producer enrolled and every consumer validated content
+    uint64_t controlInterests = 0, controlDatas = 0; ///< @brief KEY, SCHEMA and SIGN packets sent by apps
+    uint64_t contentInterests = 0, contentDatas = 0;
+    double anchorCryptoTime = 0; ///< @brief (s, wall-clock) sign/verify at the trust anchors
+  };
+
+  void updateTrustTime(TrustMetrics *metrics) {
+    if(metrics->enrollmentTime < 0 && metrics->enrolledKeys.size() >= metrics->nProducers) {
+      metrics->enrollmentTime = Simulator::Now().GetSeconds();
+    }
+    if(metrics->trustTime < 0 && metrics->enrollmentTime >= 0 &&
+       metrics->trustingConsumers.size() >= metrics->nConsumers) {
+      metrics->trustTime = Simulator::Now().GetSeconds();
+    }
+  }
+
+  void EnrollmentTrace(TrustMetrics *metrics, Ptr<ndn::App> app, const ndn::Name &certName) {
+    metrics->enrolledKeys.insert(::ndn::security::v2::extractKeyNameFromCertName(certName));
+    updateTrustTime(metrics);
+  }
+
+  void ContentValidatedTrace(TrustMetrics *metrics, Ptr<ndn::App> app, const ndn::Name &dataName) {
+    metrics->trustingConsumers.insert(app);
+    updateTrustTime(metrics);
+  }
+
+  void AnchorCryptoTimeTrace(TrustMetrics *metrics, Ptr<ndn::App> app, Time wallTime) {
+    metrics->anchorCryptoTime += wallTime.GetSeconds();
+  }
+
+  void InterestOverheadTrace(TrustMetrics *metrics, std::shared_ptr<const ndn::Interest> interest,
+                             Ptr<ndn::App> app, std::shared_ptr<ndn::Face> face) {
+    (ndn::CustomCsPolicy::isTrustData(interest->getName()) ? metrics->controlInterests
+                                                            : metrics->contentInterests)++;
+  }
+
+  void DataOverheadTrace(TrustMetrics *metrics, std::shared_ptr<const ndn::Data> data, Ptr<ndn::App> app,
+                         std::shared_ptr<ndn::Face> face) {
+    (ndn::CustomCsPolicy::isTrustData(data->getName()) ? metrics->controlDatas : metrics->contentDatas)++;
+  }
+
+  void writeTrustMetrics(const std::string &filename, const std::string &label, const TrustMetrics &metrics,
+                         double wallTime) {
+    bool writeHeader = !utils::fileExists(filename);
+    std::ofstream os(filename, std::ios::app);
+    if(writeHeader) {
+      os << "label,producers,consumers,enrollment_time_s,trust_time_s,control_interests,control_datas,"
+            "content_interests,content_datas,anchor_crypto_wall_s,sim_wall_s\n";
+    }
+    os << label << "," << metrics.nProducers << "," << metrics.nConsumers << "," << metrics.enrollmentTime
+       << "," << metrics.trustTime << "," << metrics.controlInterests << "," << metrics.controlDatas << ","
+       << metrics.contentInterests << "," << metrics.contentDatas << "," << metrics.anchorCryptoTime << ","
+       << wallTime << "\n";
+  }
+
   int main(int argc, char *argv[]) {
 
     // setting default parameters for PointToPoint links and channels
@@ -91,14 +198,59 @@ namespace ns3 {
     std::string nTraceFile = "results/mobility-trace.ns_movements";
     double nInitialEnergy = 20.0;
     size_t nCsSize = 1;
+    std::string nCsPolicy = "lru";
     size_t n_Forwarders = 1;
+    size_t n_TrustAnchors = 1;
+    size_t n_Producers = 1;
+    size_t n_Consumers = 1;
+    uint32_t nCpuCores = 0;
+    uint32_t nCryptoThreads = 0;
+    bool nCryptoEnergy = false;
+    std::string nTimeToTrust = "";
+    std::string nRunLabel = "";
+    std::string nBenchmark = "";
+    std::string nScenario = "";
+    std::string nSnapshotSave = "";
+    std::string nSnapshotLoad = "";
+    std::string nEventLog = "";
     cmd.AddValue("nSimDuration", "Simulation duration ", nSimDuration);
     cmd.AddValue("nTraceFile", "Ns2 movement trace file", nTraceFile);
     cmd.AddValue("nInitialEnergy", "Initial energy of the nodes", nInitialEnergy);
     cmd.AddValue("nCsSize", "Content Store size", nCsSize);
+    cmd.AddValue("nCsPolicy", "Content Store policy: lru, priority_fifo, trust (keeps KEY/SCHEMA Data)",
+                 nCsPolicy);
     cmd.AddValue("n_Forwarders", "Number of NDN Forwarders", n_Forwarders);
+    cmd.AddValue("n_Producers", "Number of Producers in /zoneA", n_Producers);
+    cmd.AddValue("n_Consumers", "Number of Consumers in /zoneA", n_Consumers);
+    cmd.AddValue("nCpuCores",
+                 "Cores of the simulated CPU of app nodes, sign/verify cost simulated time (0 = disabled)",
+                 nCpuCores);
+    cmd.AddValue("nCryptoThreads", "Worker threads signing/verifying Data off the simulator thread",
+                 nCryptoThreads);
+    cmd.AddValue("nCryptoEnergy",
+                 "Charge sign/verify/keygen energy to a battery (nInitialEnergy) of app nodes (remEnergy)",
+                 nCryptoEnergy);
+    cmd.AddValue("nTimeToTrust", "Append time-to-trust metrics of the run to this CSV file", nTimeToTrust);
+    cmd.AddValue("nRunLabel", "Label of the run in the time-to-trust CSV (e.g. commit id)", nRunLabel);
+    cmd.AddValue("n_TrustAnchors", "Number of Trust Anchors per zone (sharing the zone KEY)", n_TrustAnchors);
+    cmd.AddValue("nScenario", "Zones description file (INFO format), replaces the single /zoneA setup",
+                 nScenario);
+    cmd.AddValue("nSnapshotSave", "Save the state at the end of the run (keys, certificates, schema, FIB)",
+                 nSnapshotSave);
+    cmd.AddValue("nSnapshotLoad", "Start from a saved state (warm start, no bootstrap)", nSnapshotLoad);
+    cmd.AddValue("nEventLog", "Binary log of the forwarder and app events (decode with readEventLog.py)",
+                 nEventLog);
+    cmd.AddValue("nBenchmark", "Run a headless benchmark instead of the simulation (rule-index, cs-policy)",
+                 nBenchmark);
     cmd.Parse(argc, argv);
 
+    if(nBenchmark != "") {
+      if(!ndn::CustomBenchmark::run(nBenchmark, std::cout)) {
+        NS_LOG_UNCOND("Unknown benchmark '" << nBenchmark << "'");
+      }
+      return 0;
+    }
+
     // parse str commands into enums
     NS_LOG_UNCOND("TraceFile = " << nTraceFile);
 
@@ -109,7 +261,8 @@ namespace ns3 {
     ndn::StackHelper ndnHelper;
     // ndnHelper.AddNetDeviceFaceCreateCallback (WifiNetDevice::GetTypeId(),
     // MakeCallback(MyNetDeviceFaceCallback));
-    ndnHelper.setPolicy("nfd::cs::lru");
+    // trust policy is not known by StackHelper, it replaces the LRU policy once the stack is installed
+    ndnHelper.setPolicy("nfd::cs::" + (nCsPolicy == ndn::CustomCsPolicy::POLICY_NAME ? "lru" : nCsPolicy));
     ndnHelper.setCsSize(nCsSize); // forwarder->getCs().setLimit(nCsSize);
     ndnHelper.SetDefaultRoutes(true);
 
@@ -118,12 +271,17 @@ namespace ns3 {
     //////////////////////
     NS_LOG_INFO("Create NDN Zones ...");
     std::map<string, std::shared_ptr<ndn::CustomZone>> ndnZones;
-    // ZONE A => 1 consumer + 1 producer
-    std::string zoneName = "/zoneA";
-    ndnZones[zoneName] = std::make_shared<ndn::CustomZone>(zoneName, 1, 1);
-    // ZONE B => 1 consumer + 1 producer
-    // zoneName = "/zoneB";
-    // ndnZones[zoneName] = std::make_shared<ndn::CustomZone>(zoneName, 1, 1);
+    std::shared_ptr<ndn::CustomScenario> ndnScenario;
+    if(nScenario != "") {
+      // ZONES => described in scenario file
+      ndnScenario = std::make_shared<ndn::CustomScenario>(nScenario);
+      ndnZones = ndnScenario->getZones();
+    } else {
+      // ZONE A => n_Consumers consumers + n_Producers producers
+      std::string zoneName = "/zoneA";
+      ndnZones[zoneName] =
+          std::make_shared<ndn::CustomZone>(zoneName, n_Producers, n_Consumers, n_TrustAnchors);
+    }
 
     //////////////////////
     //     NODES
@@ -136,7 +294,9 @@ namespace ns3 {
       trust_anchors.Add(*pairNameZone.second->getTrustAnchors());
     }
     // every node in the network can forward NDN packets (full adhoc WiFi)
-    if(n_Forwarders > 0) {
+    if(ndnScenario != nullptr) {
+      forwarders.Add(*ndnScenario->getHubs()); // one hub per zone
+    } else if(n_Forwarders > 0) {
       forwarders.Create(n_Forwarders);
     }
     // add all nodes in the network
@@ -152,25 +312,72 @@ namespace ns3 {
     // 1. Install Links
     NS_LOG_INFO("Installing P2P links ...");
     ::ns3::PointToPointHelper p2p;
-    for(auto consumer : consumers) {
-      for(auto producer : producers) {
-        p2p.Install(consumer, producer);
+    if(ndnScenario != nullptr) {
+      ndnScenario->installLinks(p2p);
+    } else {
+      for(auto consumer : consumers) {
+        for(auto producer : producers) {
+          p2p.Install(consumer, producer);
+        }
       }
-    }
-    for(auto trust_anchor : trust_anchors) {
-      for(auto producer : producers) {
-        p2p.Install(trust_anchor, producer);
+      for(auto trust_anchor : trust_anchors) {
+        for(auto producer : producers) {
+          p2p.Install(trust_anchor, producer);
+        }
       }
-    }
-    for(auto trust_anchor : trust_anchors) {
-      for(auto forwarder : forwarders) {
-        p2p.Install(trust_anchor, forwarder);
+      for(auto trust_anchor : trust_anchors) {
+        for(auto forwarder : forwarders) {
+          p2p.Install(trust_anchor, forwarder);
+        }
       }
     }
 
     // 4. Install NDN stack
     NS_LOG_INFO("Installing NDN stack ...");
     ndnHelper.Install(nodes);
+    if(nCsPolicy == ndn::CustomCsPolicy::POLICY_NAME) {
+      for(auto node : nodes) {
+        node->GetObject<ndn::L3Protocol>()->getForwarder()->getCs().setPolicy(
+            std::make_unique<ndn::CustomCsPolicy>());
+      }
+    }
+
+    // 4.1. Real crypto off the simulator thread (same results for any number of threads > 0)
+    ndn::CustomCryptoPool::getInstance().setThreads(nCryptoThreads);
+
+    // 4.2. Simulated CPU (sign/verify processing delay)
+    NodeContainer appNodes(consumers, producers, trust_anchors);
+    NodeContainer cpuNodes;
+    if(nCpuCores > 0) {
+      NS_LOG_INFO("Installing CPU models ...");
+      cpuNodes.Add(appNodes);
+      for(auto node : cpuNodes) {
+        auto cpuModel = CreateObject<ndn::CustomCpuModel>();
+        cpuModel->SetAttribute("Cores", UintegerValue(nCpuCores));
+        node->AggregateObject(cpuModel);
+      }
+    }
+
+    // 4.3. Crypto energy (sign/verify/keygen drawn from the node battery, see remEnergy/consEnergy)
+    if(nCryptoEnergy) {
+      NS_LOG_INFO("Installing crypto energy models ...");
+      BasicEnergySourceHelper energySourceHelper;
+      energySourceHelper.Set("BasicEnergySourceInitialEnergyJ", DoubleValue(nInitialEnergy));
+      auto energySources = energySourceHelper.Install(appNodes);
+      for(auto it = energySources.Begin(); it != energySources.End(); ++it) {
+        auto energyModel = CreateObject<ndn::CustomCryptoEnergyModel>();
+        energyModel->SetEnergySource(*it);
+        (*it)->AppendDeviceEnergyModel(energyModel);
+      }
+    }
+
+    // 4.4. Warm start (apps restore keys, certificates and schema from the snapshot when they start)
+    if(nSnapshotLoad != "") {
+      NS_LOG_INFO("Loading snapshot '" << nSnapshotLoad << "' ...");
+      auto &snapshot = ndn::CustomSnapshot::getInstance();
+      snapshot.load(nSnapshotLoad);
+      snapshot.restoreRoutes();
+    }
 
     // 5. Set fw strategy
     NS_LOG_INFO("Installing NDN Forwarding Strategies ...");
@@ -212,6 +419,41 @@ namespace ns3 {
     ndn::L3RateTracer::InstallAll("results/rate-trace.txt", Seconds(1.0));
     ndn::CsTracer::InstallAll("results/cs-trace.txt", Seconds(1));
 
+    AsciiTraceHelper asciiTraceHelper;
+    auto signRetriesStream = asciiTraceHelper.CreateFileStream("results/sign-retries-trace.txt");
+    *signRetriesStream->GetStream() << "Time\tNode\tAppId\tRetries\tBackoff\n";
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$CustomProducer/SignRetries",
+                                  MakeBoundCallback(&SignRetriesTrace, signRetriesStream));
+    auto signQueueStream = asciiTraceHelper.CreateFileStream("results/sign-queue-trace.txt");
+    *signQueueStream->GetStream() << "Time\tNode\tType\tValue\n";
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$CustomTrustAnchor/SignServiceTime",
+                                  MakeBoundCallback(&SignServiceTimeTrace, signQueueStream));
+    Config::Connect("/NodeList/*/ApplicationList/*/$CustomTrustAnchor/SignQueueDepth",
+                    MakeBoundCallback(&SignQueueDepthTrace, signQueueStream));
+    auto certIssuedStream = asciiTraceHelper.CreateFileStream("results/cert-issued-trace.txt");
+    *certIssuedStream->GetStream() << "Time\tNode\tCertificate\n";
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$CustomTrustAnchor/CertificateIssued",
+                                  MakeBoundCallback(&CertificateIssuedTrace, certIssuedStream));
+
+    auto cpuStream = asciiTraceHelper.CreateFileStream("results/cpu-trace.txt");
+    *cpuStream->GetStream() << "Time\tNode\tType\tValue\n";
+    Config::Connect("/NodeList/*/$CustomCpuModel/BusyCores",
+                    MakeBoundCallback(&CpuBusyCoresTrace, cpuStream));
+
+    TrustMetrics trustMetrics;
+    trustMetrics.nProducers = producers.GetN();
+    trustMetrics.nConsumers = consumers.GetN();
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$CustomTrustAnchor/CertificateIssued",
+                                  MakeBoundCallback(&EnrollmentTrace, &trustMetrics));
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$CustomConsumer/ContentValidated",
+                                  MakeBoundCallback(&ContentValidatedTrace, &trustMetrics));
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$CustomTrustAnchor/CryptoTime",
+                                  MakeBoundCallback(&AnchorCryptoTimeTrace, &trustMetrics));
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$CustomApp/TransmittedInterests",
+                                  MakeBoundCallback(&InterestOverheadTrace, &trustMetrics));
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$CustomApp/TransmittedDatas",
+                                  MakeBoundCallback(&DataOverheadTrace, &trustMetrics));
+
     NS_LOG_INFO("Installing Custom Tracers ...");
     auto customTracer = CreateObject<CustomTracer>();
     customTracer->SetAttribute("TraceFilename", StringValue("results/dataCustomCons.dat"));
@@ -230,10 +472,46 @@ namespace ns3 {
     customTracerAnchor->SetAttribute("NodesToMonitor", NodeContainerValue(trust_anchors));
 
     // 8. Start simulation
+    if(nEventLog != "") {
+      ndn::CustomEventLog::getInstance().open(nEventLog);
+      for(auto it = NodeList::Begin(); it != NodeList::End(); ++it) {
+        ndn::CustomEventLog::getInstance().traceForwarder(*it);
+      }
+    }
     NS_LOG_INFO("Start simulation!");
     Simulator::Stop(Seconds(nSimDuration));
+    auto wallStart = std::chrono::steady_clock::now();
     Simulator::Run();
+    std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - wallStart;
+    ndn::CustomEventLog::getInstance().close();
+    for(auto node : cpuNodes) {
+      *cpuStream->GetStream() << Simulator::Now().GetSeconds() << "\t" << node->GetId() << "\tUtilization\t"
+                              << node->GetObject<ndn::CustomCpuModel>()->getUtilization() << "\n";
+    }
+    if(nTimeToTrust != "") {
+      writeTrustMetrics(nTimeToTrust, nRunLabel, trustMetrics, wallTime.count());
+    }
+    if(nSnapshotSave != "") {
+      NS_LOG_INFO("Saving snapshot '" << nSnapshotSave << "' ...");
+      auto &snapshot = ndn::CustomSnapshot::getInstance();
+      snapshot.clear();
+      for(auto it = NodeList::Begin(); it != NodeList::End(); ++it) {
+        snapshot.addRoutes(*it);
+        for(uint32_t i = 0; i < (*it)->GetNApplications(); i++) {
+          auto app = DynamicCast<ndn::CustomApp>((*it)->GetApplication(i));
+          if(app != nullptr) {
+            app->writeSnapshot(snapshot);
+          }
+        }
+      }
+      snapshot.save(nSnapshotSave);
+    }
     Simulator::Destroy();
+    // wait for pending trust schema / trust anchor file writes
+    ndn::CustomSchemaStore::getInstance().flush();
+#ifdef CUSTOM_PROFILE
+    ndn::CustomProfiler::dumpToFile("results/profile.txt");
+#endif
     return 0;
   }
 } // namespace ns3
@@ -0,0 +1,137 @@
+#!/bin/python3
+import struct
+import sys
+import os
+
+# CustomEventLog (custom-event-log.hpp) record types
+INTEREST_IN = 1
+INTEREST_OUT = 2
+DATA_IN = 3
+DATA_OUT = 4
+NACK_IN = 5
+NACK_OUT = 6
+VALIDATED = 7
+VALIDATION_FAILED = 8
+ENROLLED = 9
+CERT_ISSUED = 10
+SCHEMA_UPDATE = 11
+FWD_INTEREST_IN = 12
+FWD_DATA_IN = 13
+FWD_DATA_OUT = 14
+FWD_DATA_UNSOLICITED = 15
+FWD_NACK_OUT = 16
+FWD_SATISFIED = 17
+FWD_UNSATISFIED = 18
+CS_HIT = 19
+CS_MISS = 20
+INTEREST_TIMEOUT = 21
+
+MAGIC = b"BSEVTLOG"
+HEADER = struct.Struct("=8sII")
+RECORD = struct.Struct("=QIHHQ")
+
+
+class EventLogParser():
+
+    def __init__(self):
+        # last time data was saved into dat file
+        self.last_time = 0
+
+        # reset counters
+        self.resetCounters()
+
+        # same table as readLogfile.py (forwarders + consumer timeouts)
+        self.data = [[
+            "Time(1)", "inInterests(2)", "satisfiedInterests(3)",
+            "unsatisfiedInterests(4)", "contentStoreMisses(5)",
+            "contentStoreHits(6)", "outNacks(7)", "inDatas(8)", "outDatas(9)",
+            "unsolicitedDatas(10)", "timeoutInterests(11)"
+        ]]
+        # packets counted at the apps
+        self.appData = [[
+            "Time(1)", "inInterests(2)", "outInterests(3)", "inDatas(4)",
+            "outDatas(5)", "inNacks(6)", "outNacks(7)", "inContentBytes(8)",
+            "outContentBytes(9)"
+        ]]
+        self.events = [[
+            "Time(1)", "validated(2)", "validationFailures(3)", "enrolled(4)",
+            "certificatesIssued(5)", "schemaUpdates(6)"
+        ]]
+
+    def resetCounters(self):
+        self.counters = dict.fromkeys(range(INTEREST_IN, INTEREST_TIMEOUT + 1),
+                                      0)
+        self.bytes = dict.fromkeys((DATA_IN, DATA_OUT), 0)
+
+    def save_to_data(self):
+        c = self.counters
+        self.data.append([
+            self.last_time, c[FWD_INTEREST_IN], c[FWD_SATISFIED],
+            c[FWD_UNSATISFIED], c[CS_MISS], c[CS_HIT], c[FWD_NACK_OUT],
+            c[FWD_DATA_IN], c[FWD_DATA_OUT], c[FWD_DATA_UNSOLICITED],
+            c[INTEREST_TIMEOUT]
+        ])
+        self.appData.append([
+            self.last_time, c[INTEREST_IN], c[INTEREST_OUT], c[DATA_IN],
+            c[DATA_OUT], c[NACK_IN], c[NACK_OUT], self.bytes[DATA_IN],
+            self.bytes[DATA_OUT]
+        ])
+        self.events.append([
+            self.last_time, c[VALIDATED], c[VALIDATION_FAILED], c[ENROLLED],
+            c[CERT_ISSUED], c[SCHEMA_UPDATE]
+        ])
+        self.last_time += 1
+        self.resetCounters()
+
+    def parseRecord(self, time_ns, node, event, value):
+        time = time_ns / 1e9
+        # guarde dados no arquivo dat para graficos no gnuplot
+        while (time - self.last_time >= 1):
+            self.save_to_data()
+        if event in self.counters:
+            self.counters[event] += 1
+        if event in self.bytes:
+            self.bytes[event] += value
+
+    def readRecords(self, logfile):
+        with open(logfile, 'rb') as f:
+            magic, version, size = HEADER.unpack(f.read(HEADER.size))
+            if magic != MAGIC or version != 1 or size != RECORD.size:
+                raise ValueError("Failed to read event log file='" + logfile +
+                                 "' - Error=unknown format")
+            while True:
+                chunk = f.read(RECORD.size * 4096)
+                if not chunk:
+                    break
+                # a run killed while writing may leave a partial record at the end
+                chunk = chunk[:len(chunk) - len(chunk) % RECORD.size]
+                for record in RECORD.iter_unpack(chunk):
+                    yield record
+
+    def write(self, table, datafile):
+        with open(datafile, 'w') as f:
+            for line in table:
+                for item in line:
+                    f.write(str(item) + "\t")
+                f.write("\n")
+
+    def run(self, logfile, datafile, appdatafile, eventsfile):
+        for time_ns, node, event, flags, value in self.readRecords(logfile):
+            self.parseRecord(time_ns, node, event, value)
+        # save last pending data into dataset
+        self.save_to_data()
+        self.write(self.data, datafile)
+        self.write(self.appData, appdatafile)
+        self.write(self.events, eventsfile)
+        print("--- Read Event Log ---")
+        print(self.data)
+        print(self.events)
+        print(" ")
+
+
+if __name__ == "__main__":
+    logfile = os.path.abspath(sys.argv[1]) if len(sys.argv) > 1 else None
+    os.chdir(os.path.dirname(os.path.abspath(__file__)))
+    p = EventLogParser()
+    p.run(logfile or '../../results/events.bin', '../../results/data.dat',
+          '../../results/app-data.dat', '../../results/events.dat')
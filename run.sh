@@ -14,6 +14,8 @@ LOGFILE=${RESULTS_DIR}/logfile.log
 SIMULATION_LOG=${RESULTS_DIR}/simulation.log
 MOBILITY_LOG=${RESULTS_DIR}/mobility-trace.log
 PARSE_LOGFILE=./readLogfile.py
+EVENT_LOGFILE=${RESULTS_DIR}/events.bin
+PARSE_EVENT_LOG=./readEventLog.py
 CREATE_MOBILITY_TRACE=./createNS3mobilityTrace.sh
 
 # create link from /ndnSIM to ~/ndnSIM
@@ -82,6 +84,10 @@ if [ -z "$SHOW_LOGS" ]; then
     # set it to 0 to stop logfile generation
     SHOW_LOGS="1"
 fi
+if [ -z "$EVENT_LOG" ]; then
+    # set it to 1 to build the tables from the binary event log, with NS_LOG disabled (much faster)
+    EVENT_LOG="0"
+fi
 if [ -z "$LOGS" ]; then                
     CUSTOM_LOGS=sim_bootsec
     CUSTOM_LOGS=${CUSTOM_LOGS}:CustomApp
@@ -133,17 +139,21 @@ while [ "$REPEAT" -gt 0 ]; do
     echo -e "OK\n" ||
     ( echo "ERROR - BUILD MOBILITY TRACE FAILED" ; break )
     # START SIMULATION
-    rm -f "$LOGFILE" "$SIMULATION_LOG"
+    rm -f "$LOGFILE" "$SIMULATION_LOG" "$EVENT_LOGFILE"
     sync
     # describe simulation for easier debugging in logfile
     echo -e "-- Run WAF simulation --" | tee -a $SIMULATION_LOG
     echo -e "SHOW_LOGS = " $SHOW_LOGS | tee -a  $SIMULATION_LOG
+    echo -e "EVENT_LOG = " $EVENT_LOG | tee -a  $SIMULATION_LOG
     echo -e "SIM_FILE = " $SIM_FILE | tee -a  $SIMULATION_LOG
     echo -e "LOGS = " $LOGS | tee -a  $SIMULATION_LOG
     echo -e "GLOBAL_ARGS = " $GLOBAL_ARGS | tee -a  $SIMULATION_LOG
     echo -e "REPEAT= $REPEAT / $REPEAT_TOTAL \n" | tee -a  $SIMULATION_LOG 
     
-    if [ $SHOW_LOGS == "1" ]; then
+    if [ $EVENT_LOG == "1" ]; then
+        waf "$SIM_FILE --nEventLog=$EVENT_LOGFILE" "" "$GLOBAL_ARGS" "$@" | tee -a "$SIMULATION_LOG" &&
+        "$PARSE_EVENT_LOG" "$EVENT_LOGFILE"
+    elif [ $SHOW_LOGS == "1" ]; then
         waf "$SIM_FILE" "$LOGS" "$GLOBAL_ARGS" "$@" | tee "$LOGFILE" && 
         "$PARSE_LOGFILE"         
     else